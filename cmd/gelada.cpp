@@ -27,6 +27,15 @@
 #include <exception>
 #include <filesystem>
 #include <format>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <argparse/argparse.hpp>
 #include <BS_thread_pool.hpp>
@@ -35,25 +44,78 @@
 #include "etc/copyright/copyright.hpp"
 #include "etc/program/program.hpp"
 
+#include "lib/compression/compression.hpp"
 #include "lib/itertools/itertools.hpp"
 #include "lib/logging/logging.hpp"
-#include "lib/math/math.hpp"
+#include "lib/tempfile/tempfile.hpp"
 #include "lib/threading/hardware/hardware.hpp"
 #include "lib/timer/timer.hpp"
 
+#include "src/ast/anylang/anylang.hpp"
+#include "src/contents/contents.hpp"
+#include "src/corpus/corpus.hpp"
 #include "src/documents/execflow/execflow.hpp"
 #include "src/documents/summary/summary.hpp"
 #include "src/documents/workflow/workflow.hpp"
-#include "src/estimators/alpha/alpha.hpp"
-#include "src/ext/rapidjson/build/build.hpp"
+#include "src/kernels/kernels.hpp"
+#include "src/kvcache/kvcache.hpp"
+#include "src/languages/languages.hpp"
+#include "src/matching/matching.hpp"
+#include "src/matrices/archive/archive.hpp"
+#include "src/matrices/matrices.hpp"
+#include "src/pipeline/pipeline.hpp"
+#include "src/scorecache/scorecache.hpp"
+#include "src/sketches/sketches.hpp"
 
 namespace args {
 
 constexpr const int dof = 2;
+constexpr const char* estimator = "levenshtein";
+constexpr double epsilon = 1e-9;
+constexpr const char* kernel = "auto";
 const int threads = threading::hardware::threads();
 
 }  // namespace args
 
+namespace args::approximate {
+
+constexpr int repetitions = 8;
+
+}  // namespace args::approximate
+
+namespace args::corpus {
+
+constexpr std::size_t candidates = 16;
+constexpr double overlap = 0.10;
+
+}  // namespace args::corpus
+
+namespace args::gst {
+
+constexpr int minimum = 9;
+
+}  // namespace args::gst
+
+namespace args::lsh {
+
+constexpr int bands = 32;
+constexpr int rows = 2;
+
+}  // namespace args::lsh
+
+namespace args::output {
+
+constexpr const char* compression = "none";
+constexpr const char* format = "json";
+
+}  // namespace args::output
+
+namespace args::rematch {
+
+constexpr std::size_t window = 64;
+
+}  // namespace args::rematch
+
 namespace args::threshold {
 
 constexpr double alpha = 0.30;
@@ -91,7 +153,388 @@ void flush(void) {
 
 } // namespace warnings::buffer
 
+namespace report::buffer {
+
+std::vector<std::string> storage;
+
+void flush(void) {
+    for (const auto& line : storage) {
+        logging::trace(line);
+    }
+
+    storage.clear();
+}
+
+}  // namespace report::buffer
+
+namespace comments {
+
+/* Nothing, a text comment or a comment packed for the binary summary */
+using Serialized = std::variant<std::monostate, std::string, documents::summary::Packed>;
+
+/* Serializes the matchings of the submission pair, nothing if there are none */
+Serialized serialize(
+    const std::string& cheater_name,
+    const std::string& author_name,
+    const std::vector<std::string>& lhs_labels,
+    const std::vector<std::string>& rhs_labels,
+    const std::vector<matching::Matching>& rows,
+    documents::summary::Format format
+) {
+    std::vector<documents::summary::Matching> matchings;
+
+    for (std::size_t lidx = 0; lidx < lhs_labels.size(); ++lidx) {
+        const auto& row = rows[lidx];
+
+        if (row.confidence == 0.0) {
+            continue;
+        }
+
+        documents::summary::Matching matching{lhs_labels[lidx], row.confidence, {}};
+
+        for (const auto& ridx : row.sources) {
+            matching.sources.push_back(rhs_labels[ridx]);
+        }
+
+        matchings.push_back(std::move(matching));
+    }
+
+    if (matchings.empty()) {
+        return {};
+    }
+
+    auto comparator = [](const auto& lhs, const auto& rhs) {
+        return lhs.confidence > rhs.confidence;
+    };
+    std::sort(matchings.begin(), matchings.end(), comparator);
+
+    if (format == documents::summary::Format::binary) {
+        return documents::summary::pack(cheater_name, author_name, matchings);
+    }
+
+    return documents::summary::comment(cheater_name, author_name, matchings, format);
+}
+
+/* Appends the serialized comment to the summary, if there is one */
+void append(documents::summary::Stream& summary, const Serialized& serialized) {
+    if (const auto* text = std::get_if<std::string>(&serialized)) {
+        summary.write(*text);
+    }
+
+    if (const auto* packed = std::get_if<documents::summary::Packed>(&serialized)) {
+        summary.write(*packed);
+    }
+}
+
+}  // namespace comments
+
+namespace output {
+
+/* The requested path if it can be written, a temporary file otherwise */
+std::filesystem::path destination(const std::optional<std::filesystem::path>& requested) {
+    if (!requested) {
+        return tempfile::mkstemp();
+    }
+
+    if (std::filesystem::exists(*requested) && !std::filesystem::is_regular_file(*requested)) {
+        logging::warning(std::format(
+            "The output path {} is not writable",
+            requested->string()));
+        logging::newline();
+
+        return tempfile::mkstemp();
+    }
+
+    return *requested;
+}
+
+}  // namespace output
+
+/* Matches the files anew on the saved score matrices, no submission is compared */
+int rematch(int argc, char* argv[]) {
+    auto cli = argparse::ArgumentParser(
+        std::format("{} rematch", etc::program::name),
+        etc::program::version);
+
+    cli.add_argument("matrices")
+        .help("the path to the matrices saved by '--save-matrices'")
+        .metavar("MATRICES");
+
+    cli.add_argument("-at", "--alpha-threshold")
+        .default_value(args::threshold::alpha)
+        .help("specifies the alpha threshold")
+        .metavar("AT")
+        .nargs(1)
+        .scan<'g', double>();
+
+    cli.add_argument("-dof", "--degree-of-freedom")
+        .default_value(args::dof)
+        .help("limits the degree of freedom")
+        .metavar("DOF")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_argument("-o", "--output")
+        .help("specifies the output file")
+        .metavar("PATH");
+
+    cli.add_argument("-oc", "--output-compression")
+        .default_value(std::string{args::output::compression})
+        .choices("gzip", "none", "zstd")
+        .help("specifies the compression of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-of", "--output-format")
+        .default_value(std::string{args::output::format})
+        .choices("binary", "json", "jsonl")
+        .help("specifies the layout of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-t", "--threads")
+        .default_value(args::threads)
+        .help("limits the number of threads")
+        .metavar("T")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_epilog(std::format(
+        "{}, Copyright (c) 2024 {}",
+        etc::copyright::license,
+        etc::copyright::author));
+
+    try {
+        cli.parse_args(argc, argv);
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    auto alpha_threshold = cli.get<double>("alpha-threshold");
+    if (alpha_threshold < 0) {
+        logging::error("The alpha-threshold must be non-negative");
+        return EXIT_FAILURE;
+    }
+
+    auto dof = cli.get<int>("degree-of-freedom");
+    if (dof <= 0) {
+        logging::error("The degree of freedom must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto threads = cli.get<int>("threads");
+    if (threads <= 0) {
+        logging::error("The number of threads must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto output_codec = compression::parse(cli.get<std::string>("output-compression"));
+    auto output_format = documents::summary::parse(cli.get<std::string>("output-format"));
+
+    if (output_format == documents::summary::Format::binary && output_codec != compression::Codec::none) {
+        output_codec = compression::Codec::none;
+        auto detail = "The '--output-compression' option has no effect on the binary summary";
+        warnings::buffer::storage.push_back(detail);
+    }
+
+    timer::Timer timer;
+    timer.start();
+
+    std::unique_ptr<matrices::archive::Reader> archive;
+
+    try {
+        archive = std::make_unique<matrices::archive::Reader>(cli.get<std::string>("matrices"));
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    /* Only the exact scores reaching the threshold of the original run were saved */
+    if (alpha_threshold < archive->threshold()) {
+        warnings::buffer::storage.push_back(std::format(
+            "The matrices keep only the scores reaching the alpha-threshold {}, it is used instead",
+            archive->threshold()));
+        alpha_threshold = archive->threshold();
+    }
+
+    /* Without best-first, every score reaching the threshold was saved */
+    if (dof > archive->dof() && archive->best_first()) {
+        warnings::buffer::storage.push_back(std::format(
+            "The matrices were saved with the DOF {}, the pairs left by '--best-first' are missing",
+            archive->dof()));
+    }
+
+    warnings::buffer::flush();
+
+    std::optional<std::filesystem::path> requested;
+
+    if (cli.is_used("output")) {
+        requested = cli.get<std::string>("output");
+    }
+
+    auto path_to_output = output::destination(requested);
+    std::unique_ptr<documents::summary::Stream> summary;
+
+    try {
+        summary = std::make_unique<documents::summary::Stream>(path_to_output, output_format, output_codec);
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    BS::thread_pool pool(threads);
+
+    /* Each block is serialized by a worker, the buffers are written in the order of the blocks */
+    auto window = static_cast<std::size_t>(threads) * args::rematch::window;
+    std::vector<comments::Serialized> buffers;
+
+    for (std::size_t first = 0; first < archive->size(); first += window) {
+        auto last = std::min(first + window, archive->size());
+        buffers.assign(last - first, comments::Serialized{});
+
+        for (std::size_t block = first; block < last; ++block) {
+            auto task = pool.submit_task([&, first, block]{
+                auto pair = archive->pair(block);
+                std::vector<matching::Matching> rows;
+
+                for (std::size_t lidx = 0; lidx < pair.lhs_labels.size(); ++lidx) {
+                    rows.push_back(matching::best(archive->row(block, lidx), dof, alpha_threshold));
+                }
+
+                buffers[block - first] = comments::serialize(
+                    pair.cheater,
+                    pair.author,
+                    pair.lhs_labels,
+                    pair.rhs_labels,
+                    rows,
+                    output_format);
+            });
+        }
+
+        pool.wait();
+
+        for (const auto& buffer : buffers) {
+            comments::append(*summary, buffer);
+        }
+    }
+
+    try {
+        summary->close();
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    auto detail = std::format(
+        "The summary is available at {}",
+        std::filesystem::weakly_canonical(path_to_output).string());
+    logging::info(detail);
+
+    report::buffer::storage.push_back(std::format(
+        "The rematch covered {} submission pairs",
+        archive->size()));
+
+    report::buffer::flush();
+
+    timer.finish();
+    logging::trace(timer);
+
+    return EXIT_SUCCESS;
+}
+
+/* Converts the binary summary back to the JSON protocol */
+int convert(int argc, char* argv[]) {
+    auto cli = argparse::ArgumentParser(
+        std::format("{} convert", etc::program::name),
+        etc::program::version);
+
+    cli.add_argument("summary")
+        .help("the path to the summary written with '--output-format binary'")
+        .metavar("SUMMARY");
+
+    cli.add_argument("-o", "--output")
+        .help("specifies the output file")
+        .metavar("PATH");
+
+    cli.add_argument("-oc", "--output-compression")
+        .default_value(std::string{args::output::compression})
+        .choices("gzip", "none", "zstd")
+        .help("specifies the compression of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-of", "--output-format")
+        .default_value(std::string{args::output::format})
+        .choices("json", "jsonl")
+        .help("specifies the layout of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_epilog(std::format(
+        "{}, Copyright (c) 2024 {}",
+        etc::copyright::license,
+        etc::copyright::author));
+
+    try {
+        cli.parse_args(argc, argv);
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    auto output_codec = compression::parse(cli.get<std::string>("output-compression"));
+    auto output_format = documents::summary::parse(cli.get<std::string>("output-format"));
+
+    timer::Timer timer;
+    timer.start();
+
+    std::optional<std::filesystem::path> requested;
+
+    if (cli.is_used("output")) {
+        requested = cli.get<std::string>("output");
+    }
+
+    auto path_to_output = output::destination(requested);
+
+    try {
+        documents::summary::convert(
+            cli.get<std::string>("summary"),
+            path_to_output,
+            output_format,
+            output_codec);
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    auto detail = std::format(
+        "The summary is available at {}",
+        std::filesystem::weakly_canonical(path_to_output).string());
+    logging::info(detail);
+
+    timer.finish();
+    logging::trace(timer);
+
+    return EXIT_SUCCESS;
+}
+
 int main(int argc, char* argv[]) {
+    /* The subcommands need neither the interpreter nor the submissions */
+    if (argc > 1 && std::string_view(argv[1]) == "rematch") {
+        return rematch(argc - 1, argv + 1);
+    }
+
+    if (argc > 1 && std::string_view(argv[1]) == "convert") {
+        return convert(argc - 1, argv + 1);
+    }
+
     auto program = Py_DecodeLocale(argv[0], NULL);
     if (!program) {
         logging::error("Failed to decode argv[0]");
@@ -122,10 +565,57 @@ int main(int argc, char* argv[]) {
         .nargs(1)
         .scan<'g', double>();
 
+    cli.add_argument("-ap", "--approximate")
+        .help("estimates the Levenshtein distance from the CGK embeddings of the files")
+        .flag();
+
+    cli.add_argument("-ar", "--approximate-repetitions")
+        .default_value(args::approximate::repetitions)
+        .help("specifies the number of CGK random walks per file")
+        .metavar("R")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_argument("-bf", "--best-first")
+        .help("compares the files exactly only while they may be among the DOF best sources")
+        .flag();
+
+    cli.add_argument("-c", "--corpus")
+        .help("checks the submissions against the corpus of past submissions")
+        .metavar("PATH");
+
+    cli.add_argument("-cl", "--corpus-label")
+        .help("labels the submissions within the corpus, e.g. by the semester")
+        .metavar("LABEL")
+        .nargs(1);
+
+    cli.add_argument("-ch", "--chunks")
+        .help("compares the functions and the classes of the files instead of whole files")
+        .flag();
+
+    cli.add_argument("-cd", "--cache-dir")
+        .help("specifies the cache directory")
+        .metavar("PATH");
+
+    cli.add_argument("-dc", "--disable-cache")
+        .help("disables the persistent score cache")
+        .flag();
+
     cli.add_argument("-dn", "--disable-normalization")
         .help("disables AST normalization")
         .flag();
 
+    cli.add_argument("-e", "--estimator")
+        .default_value(std::string{args::estimator})
+        .choices("fragments", "gst", "levenshtein", "winnowing")
+        .help("specifies the similarity estimator")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-ec", "--extend-corpus")
+        .help("adds the submissions to the corpus")
+        .flag();
+
     cli.add_argument("-dof", "--degree-of-freedom")
         .default_value(args::dof)
         .help("limits the degree of freedom")
@@ -133,10 +623,74 @@ int main(int argc, char* argv[]) {
         .nargs(1)
         .scan<'i', int>();
 
+    cli.add_argument("-gm", "--gst-minimum")
+        .default_value(args::gst::minimum)
+        .help("specifies the minimum tile length of the token-based estimators")
+        .metavar("M")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_argument("-k", "--kernel")
+        .default_value(std::string{args::kernel})
+        .choices("auto", "avx2", "avx512", "scalar", "sse42")
+        .help("specifies the instruction set of the estimator kernels")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-lsh", "--lsh")
+        .help("compares only the files colliding in the MinHash LSH index")
+        .flag();
+
+    cli.add_argument("-lb", "--lsh-bands")
+        .default_value(args::lsh::bands)
+        .help("specifies the number of LSH bands")
+        .metavar("B")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_argument("-lr", "--lsh-rows")
+        .default_value(args::lsh::rows)
+        .help("specifies the number of MinHash rows per LSH band")
+        .metavar("R")
+        .nargs(1)
+        .scan<'i', int>();
+
+    cli.add_argument("-ms", "--mutual-suspects")
+        .help("compares the suspects with each other as well")
+        .flag();
+
     cli.add_argument("-o", "--output")
         .help("specifies the output file")
         .metavar("PATH");
 
+    cli.add_argument("-oc", "--output-compression")
+        .default_value(std::string{args::output::compression})
+        .choices("gzip", "none", "zstd")
+        .help("specifies the compression of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-of", "--output-format")
+        .default_value(std::string{args::output::format})
+        .choices("binary", "json", "jsonl")
+        .help("specifies the layout of the output file")
+        .metavar("NAME")
+        .nargs(1);
+
+    cli.add_argument("-p", "--plan")
+        .help("explains the strategies chosen for the file pairs and their cost")
+        .flag();
+
+    cli.add_argument("-pt", "--prefilter-threshold")
+        .help("skips the pairs whose fingerprint overlap is below the threshold")
+        .metavar("PT")
+        .nargs(1)
+        .scan<'g', double>();
+
+    cli.add_argument("-sm", "--save-matrices")
+        .help("saves the score matrices for 'gelada rematch'")
+        .metavar("PATH");
+
     cli.add_argument("-sc", "--single-check")
         .help("defines the number of checks based on DOF")
         .flag();
@@ -148,6 +702,12 @@ int main(int argc, char* argv[]) {
         .nargs(1)
         .scan<'i', int>();
 
+    cli.add_argument("-vm", "--verify-margin")
+        .help("verifies the approximate scores this close to the alpha-threshold exactly")
+        .metavar("VM")
+        .nargs(1)
+        .scan<'g', double>();
+
     cli.add_epilog(std::format(
         "{}, Copyright (c) 2024 {}",
         etc::copyright::license,
@@ -167,6 +727,18 @@ int main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    if (cli.is_used("cache-dir")) {
+        std::filesystem::path cache_dir = cli.get<std::string>("cache-dir");
+
+        if (std::filesystem::exists(cache_dir) && !std::filesystem::is_directory(cache_dir)) {
+            logging::error("The cache directory is not a directory");
+            return EXIT_FAILURE;
+        }
+
+        kvcache::configure(cache_dir);
+    }
+
+    auto disable_cache = cli.get<bool>("disable-cache");
     auto disable_normalization = cli.get<bool>("disable-normalization");
 
     auto dof = cli.get<int>("degree-of-freedom");
@@ -181,6 +753,15 @@ int main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    auto output_codec = compression::parse(cli.get<std::string>("output-compression"));
+    auto output_format = documents::summary::parse(cli.get<std::string>("output-format"));
+
+    if (output_format == documents::summary::Format::binary && output_codec != compression::Codec::none) {
+        output_codec = compression::Codec::none;
+        auto detail = "The '--output-compression' option has no effect on the binary summary";
+        warnings::buffer::storage.push_back(detail);
+    }
+
     if (alpha_threshold <= warnings::limit::threshold::alpha) {
         warnings::buffer::storage.push_back(std::format(
             "Recommended to use the alpha-threshold no less than {}",
@@ -193,6 +774,134 @@ int main(int argc, char* argv[]) {
             warnings::limit::dof));
     }
 
+    auto kernel = cli.get<std::string>("kernel");
+
+    /* The option overrides the environment, the environment overrides the CPUID */
+    if (!cli.is_used("kernel")) {
+        if (auto variable = std::getenv("GELADA_KERNEL"); variable && *variable) {
+            kernel = variable;
+        }
+    }
+
+    if (kernel != "auto") {
+        try {
+            kernels::select(kernels::parse(kernel));
+        }
+        catch (const std::exception& exc) {
+            logging::error(exc.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto estimator = cli.get<std::string>("estimator");
+
+    auto gst_minimum = cli.get<int>("gst-minimum");
+    if (gst_minimum <= 0) {
+        logging::error("The minimum tile length must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto chunking = cli.get<bool>("chunks");
+    if (chunking && (estimator == "fragments" || estimator == "winnowing")) {
+        chunking = false;
+        warnings::buffer::storage.push_back(std::format(
+            "The '--chunks' option has no effect on the {} estimator",
+            estimator));
+    }
+
+    auto approximate = cli.get<bool>("approximate");
+    if (approximate && (chunking || estimator == "fragments" || estimator == "gst")) {
+        approximate = false;
+        auto detail = "The '--approximate' option has effect only on whole files compared by Levenshtein";
+        warnings::buffer::storage.push_back(detail);
+    }
+
+    auto approximate_repetitions = cli.get<int>("approximate-repetitions");
+    if (approximate_repetitions <= 0) {
+        logging::error("The number of CGK repetitions must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto verify = cli.is_used("verify-margin");
+    auto verify_margin = verify ? cli.get<double>("verify-margin") : 0.0;
+
+    if (verify_margin < 0) {
+        logging::error("The verify-margin must be non-negative");
+        return EXIT_FAILURE;
+    }
+
+    if (verify && !approximate) {
+        verify = false;
+        auto detail = "The '--verify-margin' option is active only with '--approximate'";
+        warnings::buffer::storage.push_back(detail);
+    }
+
+    auto best_first = cli.get<bool>("best-first");
+    if (best_first && (approximate || chunking || estimator == "fragments" || estimator == "gst")) {
+        best_first = false;
+        auto detail = "The '--best-first' option has effect only on whole files compared by Levenshtein";
+        warnings::buffer::storage.push_back(detail);
+    }
+
+    auto extend_corpus = cli.get<bool>("extend-corpus");
+    if (extend_corpus && !cli.is_used("corpus")) {
+        logging::error("The '--extend-corpus' option requires '--corpus'");
+        return EXIT_FAILURE;
+    }
+
+    if (extend_corpus && !cli.is_used("corpus-label")) {
+        logging::error("The '--extend-corpus' option requires '--corpus-label'");
+        return EXIT_FAILURE;
+    }
+
+    std::string corpus_label;
+
+    if (cli.is_used("corpus-label")) {
+        if (!cli.is_used("corpus")) {
+            logging::error("The '--corpus-label' option requires '--corpus'");
+            return EXIT_FAILURE;
+        }
+
+        corpus_label = cli.get<std::string>("corpus-label");
+
+        if (corpus_label.empty() || corpus_label.find('/') != std::string::npos) {
+            logging::error("The corpus label must be non-empty and free of slashes");
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto use_lsh = cli.get<bool>("lsh");
+
+    auto lsh_bands = cli.get<int>("lsh-bands");
+    if (lsh_bands <= 0) {
+        logging::error("The number of LSH bands must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto lsh_rows = cli.get<int>("lsh-rows");
+    if (lsh_rows <= 0) {
+        logging::error("The number of LSH rows must be positive");
+        return EXIT_FAILURE;
+    }
+
+    auto mutual_suspects = cli.get<bool>("mutual-suspects");
+
+    auto explain = cli.get<bool>("plan");
+
+    auto prefilter = cli.is_used("prefilter-threshold");
+    auto prefilter_threshold = prefilter ? cli.get<double>("prefilter-threshold") : 0.0;
+
+    if (!(0.0 <= prefilter_threshold && prefilter_threshold <= 1.0)) {
+        logging::error("The prefilter-threshold must be in the range from 0.0 to 1.0");
+        return EXIT_FAILURE;
+    }
+
+    if (prefilter && estimator == "winnowing") {
+        prefilter = false;
+        auto detail = "The '--prefilter-threshold' option has no effect on the winnowing estimator";
+        warnings::buffer::storage.push_back(detail);
+    }
+
     auto single_check = cli.get<bool>("single-check");
     if (single_check && dof != 1) {
         single_check = false;
@@ -221,6 +930,34 @@ int main(int argc, char* argv[]) {
     timer::Timer timer;
     timer.start();
 
+    std::unique_ptr<corpus::Index> index;
+
+    if (cli.is_used("corpus")) {
+        try {
+            index = std::make_unique<corpus::Index>(cli.get<std::string>("corpus"));
+        }
+        catch (const std::exception& exc) {
+            logging::error(exc.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::unique_ptr<matrices::archive::Writer> archive;
+
+    if (cli.is_used("save-matrices")) {
+        try {
+            archive = std::make_unique<matrices::archive::Writer>(
+                cli.get<std::string>("save-matrices"),
+                alpha_threshold,
+                dof,
+                best_first);
+        }
+        catch (const std::exception& exc) {
+            logging::error(exc.what());
+            return EXIT_FAILURE;
+        }
+    }
+
     rapidjson::Document execflow;
     rapidjson::Document workflow;
 
@@ -237,11 +974,211 @@ int main(int argc, char* argv[]) {
         documents::execflow::parallel::normalize(execflow, threads);
     }
 
-    rapidjson::Document summary = documents::summary::sketch();
-    std::mutex docmutex;
+    /* Stripped once here, the boilerplate costs nothing per pair */
+    auto boilerplate = documents::execflow::parallel::strip(execflow, threads);
+
+    if (execflow.HasMember("boilerplate")) {
+        report::buffer::storage.push_back(std::format(
+            "The boilerplate subtraction removed {} lines",
+            boilerplate));
+    }
+
+    std::optional<std::filesystem::path> requested;
+
+    if (cli.is_used("output")) {
+        requested = cli.get<std::string>("output");
+    }
+
+    /* The comments are written as soon as their submission pairs are matched */
+    auto path_to_output = output::destination(requested);
+    std::unique_ptr<documents::summary::Stream> summary;
+
+    try {
+        summary = std::make_unique<documents::summary::Stream>(path_to_output, output_format, output_codec);
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
 
     BS::thread_pool pool(threads);
 
+    contents::Store contents;
+    std::unordered_map<std::string, std::vector<std::filesystem::path>> files;
+    std::unordered_map<std::string, std::vector<std::string>> labels;
+
+    /* Every file is read and hashed once, not once per submission pair */
+    for (const auto& submission : execflow["submissions"].GetArray()) {
+        std::string name = submission["name"].GetString();
+        std::filesystem::path path = submission["path"].GetString();
+
+        files[name] = itertools::collect::regular_files(path);
+
+        /* The order of the directory listing is unspecified, so twins are sorted alike */
+        std::sort(files[name].begin(), files[name].end());
+
+        for (const auto& file : files[name]) {
+            labels[name].push_back(std::filesystem::relative(file, path).string());
+        }
+
+        for (const auto& file : files[name]) {
+            auto task = pool.submit_task([&, file]{ contents.load(file); });
+        }
+    }
+
+    pool.wait();
+
+    languages::Table compatibilities;
+
+    if (execflow.HasMember("compatibility")) {
+        for (const auto& group : execflow["compatibility"].GetArray()) {
+            std::vector<std::string> kin;
+
+            for (const auto& language : group.GetArray()) {
+                kin.push_back(language.GetString());
+            }
+
+            compatibilities.join(kin);
+        }
+    }
+
+    std::string normalization = disable_normalization ? "none" : ast::anylang::version;
+
+    pipeline::Options options{
+        estimator,
+        normalization,
+        alpha_threshold,
+        dof,
+        static_cast<std::size_t>(gst_minimum),
+        chunking,
+        approximate,
+        static_cast<std::size_t>(approximate_repetitions),
+        verify ? std::optional<double>(verify_margin) : std::nullopt,
+        prefilter ? std::optional<double>(prefilter_threshold) : std::nullopt,
+        !disable_cache};
+
+    pipeline::Pipeline scorer(options, contents, pool);
+    scorer.classify(files, compatibilities, pool);
+
+    /* Twin submissions share the digest of their trees */
+    std::unordered_map<std::string, std::string> trees;
+    std::unordered_map<std::string, std::size_t> twins;
+
+    for (const auto& [name, submission_files] : files) {
+        std::vector<const contents::Content*> submission_contents;
+
+        for (const auto& file : submission_files) {
+            submission_contents.push_back(&contents.load(file));
+        }
+
+        trees[name] = contents::merkle(labels[name], submission_contents);
+        twins[trees[name]] += 1;
+    }
+
+    if (use_lsh) {
+        scorer.bucket(
+            files,
+            static_cast<std::size_t>(lsh_bands),
+            static_cast<std::size_t>(lsh_rows),
+            pool);
+    }
+
+    if (estimator == "fragments") {
+        scorer.cover(files);
+    }
+
+    std::size_t pairs = 0;
+    std::size_t kept = 0;
+
+    std::unordered_map<std::string, sketches::Sketch> sketchbook;
+
+    for (const auto& [name, submission_files] : files) {
+        std::vector<const contents::Content*> submission_contents;
+
+        for (const auto& file : submission_files) {
+            submission_contents.push_back(&contents.load(file));
+        }
+
+        sketchbook[name] = sketches::build(submission_contents);
+    }
+
+    std::size_t gated = 0;
+
+    std::unordered_map<std::string, matrices::Sparse> memoized;
+    std::unordered_map<std::string, std::size_t> archived;
+    std::size_t reused = 0;
+
+    auto is_suspect = [](const rapidjson::Value& submission) {
+        return submission.HasMember("suspect") && submission["suspect"].GetBool();
+    };
+
+    /* Without suspects, every submission is checked against every other one */
+    bool has_suspects = std::any_of(
+        execflow["submissions"].Begin(),
+        execflow["submissions"].End(),
+        is_suspect);
+
+    if (!has_suspects && mutual_suspects) {
+        logging::warning("The '--mutual-suspects' option is active only with suspects");
+        logging::newline();
+    }
+
+    /* Proves that no file pair of the submissions reaches the alpha-threshold */
+    auto hopeless = [&](const std::string& lhs_name, const std::string& rhs_name) {
+        const auto& sketch = sketchbook.at(rhs_name);
+
+        for (const auto& file : files[lhs_name]) {
+            if (scorer.bound(contents.load(file), sketch) + args::epsilon >= alpha_threshold) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    /* Appends the matchings of the submission pair to the summary */
+    auto comment = [&](
+        const std::string& cheater_name,
+        const std::string& author_name,
+        const std::vector<std::string>& lhs_labels,
+        const std::vector<std::string>& rhs_labels,
+        const matrices::Sparse& matrix
+    ) {
+        std::vector<matching::Matching> rows(lhs_labels.size());
+
+        for (std::size_t lidx = 0; lidx < lhs_labels.size(); ++lidx) {
+            auto task = pool.submit_task([&, lidx]{
+                rows[lidx] = matching::best(matrix.row(lidx), dof, alpha_threshold);
+            });
+        }
+
+        pool.wait();
+
+        auto serialized = comments::serialize(
+            cheater_name,
+            author_name,
+            lhs_labels,
+            rhs_labels,
+            rows,
+            output_format);
+
+        comments::append(*summary, serialized);
+    };
+
+    /* Saves only the scores reaching the threshold, the lower ones may be bounds rather than scores */
+    auto persist = [&](
+        const std::string& cheater_name,
+        const std::string& author_name,
+        const std::vector<std::string>& lhs_labels,
+        const std::vector<std::string>& rhs_labels,
+        const matrices::Dense& matrix
+    ) {
+        auto cheater = archive->submission(cheater_name, lhs_labels);
+        auto author = archive->submission(author_name, rhs_labels);
+
+        return archive->add(cheater, author, matrices::Sparse(matrix));
+    };
+
     for (const auto& lhs_submission : execflow["submissions"].GetArray()) {
         for (const auto& rhs_submission : execflow["submissions"].GetArray()) {
             std::string lhs_name = lhs_submission["name"].GetString();
@@ -255,165 +1192,285 @@ int main(int argc, char* argv[]) {
                 continue;
             }
 
-            rapidjson::Value submissions;
-            submissions.SetObject();
+            if (has_suspects) {
+                auto lhs_suspect = is_suspect(lhs_submission);
+                auto rhs_suspect = is_suspect(rhs_submission);
+
+                if (!lhs_suspect && !rhs_suspect) {
+                    continue;
+                }
+
+                if (lhs_suspect && rhs_suspect && !mutual_suspects) {
+                    continue;
+                }
+            }
+
+            if (hopeless(lhs_name, rhs_name)) {
+                gated += 1;
+                continue;
+            }
 
-            auto cheater = rapidjson::build::string(lhs_name, summary.GetAllocator());
-            auto author = rapidjson::build::string(rhs_name, summary.GetAllocator());
+            /* The matrices of twin submissions are computed once */
+            auto twinned = twins[trees[lhs_name]] > 1 || twins[trees[rhs_name]] > 1;
+            auto twin_key = std::format("{}:{}", trees[lhs_name], trees[rhs_name]);
 
-            submissions.AddMember("cheater", cheater, summary.GetAllocator());
-            submissions.AddMember("author", author, summary.GetAllocator());
+            if (twinned && memoized.contains(twin_key)) {
+                reused += 1;
+                comment(lhs_name, rhs_name, labels[lhs_name], labels[rhs_name], memoized.at(twin_key));
 
-            rapidjson::Value matchings;
-            matchings.SetArray();
+                if (archive) {
+                    archive->alias(
+                        archive->submission(lhs_name, labels[lhs_name]),
+                        archive->submission(rhs_name, labels[rhs_name]),
+                        archived.at(twin_key));
+                }
 
-            std::filesystem::path lhs_path = lhs_submission["path"].GetString();
-            std::filesystem::path rhs_path = rhs_submission["path"].GetString();
+                continue;
+            }
 
-            auto lhs_files = itertools::collect::regular_files(lhs_path);
-            auto rhs_files = itertools::collect::regular_files(rhs_path);
+            const auto& lhs_files = files[lhs_name];
+            const auto& rhs_files = files[rhs_name];
 
             assert(lhs_files.size() != 0);
             assert(rhs_files.size() != 0);
 
-            std::vector matrix(lhs_files.size(), std::vector<double>(rhs_files.size()));
+            matrices::Dense matrix(lhs_files.size(), rhs_files.size(), alpha_threshold);
+            pairs += lhs_files.size() * rhs_files.size();
 
-            for (std::size_t lidx = 0; lidx < lhs_files.size(); ++lidx) {
-                for (std::size_t ridx = 0; ridx < rhs_files.size(); ++ridx) {
-                    auto task = pool.submit_task([&, lidx, ridx]{
-                        auto lhs = lhs_files[lidx];
-                        auto rhs = rhs_files[ridx];
+            /* A row is filled by a handful of tasks, a batch of columns each */
+            auto width = scorer.batched() ? kernels::lanes : std::size_t{1};
+
+            for (std::size_t lidx = 0; best_first && lidx < lhs_files.size(); ++lidx) {
+                auto task = pool.submit_task([&, lidx]{
+                    scorer.descend(matrix, lidx, lhs_files, rhs_files);
+                });
+            }
+
+            for (std::size_t lidx = 0; !best_first && lidx < lhs_files.size(); ++lidx) {
+                for (std::size_t first = 0; first < rhs_files.size(); first += width) {
+                    auto last = std::min(first + width, rhs_files.size());
 
-                        auto score = estimators::alpha::levenshtein(lhs, rhs);
-                        matrix[lidx][ridx] = score;
+                    auto task = pool.submit_task([&, lidx, first, last]{
+                        scorer.fill(matrix, lidx, lhs_files, rhs_files, first, last);
                     });
                 }
             }
 
             pool.wait();
 
-            /* There may be fewer files than the user-specified DOF */
-            auto matching_size = std::min<std::size_t>(dof, rhs_files.size());
+            /* Only the cells above the threshold may enter a matching */
+            matrices::Sparse sparse(matrix);
+            kept += sparse.size();
 
-            for (std::size_t lidx = 0; lidx < lhs_files.size(); ++lidx) {
-                auto task = pool.submit_task([&, lidx]{
-                    auto lhs = lhs_files[lidx];
+            comment(lhs_name, rhs_name, labels[lhs_name], labels[rhs_name], sparse);
 
-                    std::vector<std::filesystem::path> suspects;
-                    double confidence = 0.0;
+            if (archive) {
+                auto block = persist(lhs_name, rhs_name, labels[lhs_name], labels[rhs_name], matrix);
 
-                    std::vector<std::filesystem::path> candidates;
-                    std::vector<double> probabilities;
+                if (twinned) {
+                    archived.emplace(twin_key, block);
+                }
+            }
 
-                    for (std::size_t size = 1; size <= matching_size; ++size) {
-                        auto combinations = itertools::combinations(rhs_files.size(), size);
+            if (twinned) {
+                memoized.emplace(twin_key, std::move(sparse));
+            }
+        }
+    }
 
-                        for (const auto& indices : combinations) {
-                            bool skip = false;
+    if (index) {
+        for (const auto& submission : execflow["submissions"].GetArray()) {
+            if (has_suspects && !is_suspect(submission)) {
+                continue;
+            }
 
-                            candidates.clear();
-                            probabilities.clear();
+            std::string name = submission["name"].GetString();
+            const auto& lhs_files = files[name];
 
-                            for (const auto& ridx : indices) {
-                                auto prob = matrix[lidx][ridx];
+            std::vector<std::vector<corpus::Candidate>> retrieved(lhs_files.size());
 
-                                if (prob < alpha_threshold) {
-                                    skip = true;
-                                    break;
-                                }
+            for (std::size_t lidx = 0; lidx < lhs_files.size(); ++lidx) {
+                auto task = pool.submit_task([&, lidx]{
+                    const auto& lhs = contents.load(lhs_files[lidx]);
+                    retrieved[lidx] = index->query(
+                        lhs.text,
+                        args::corpus::candidates,
+                        args::corpus::overlap,
+                        corpus_label);
+                });
+            }
 
-                                candidates.push_back(rhs_files[ridx]);
-                                probabilities.push_back(prob);
-                            }
+            pool.wait();
 
-                            if (skip) {
-                                continue;
-                            }
+            /* Only the retrieved files of each past submission are verified */
+            std::map<std::string, std::vector<std::uint32_t>> authors;
 
-                            auto probability = math::probability::gmean(probabilities);
-                            if (probability > confidence) {
-                                suspects = candidates;
-                                confidence = probability;
-                            }
-                        }
+            for (const auto& candidates : retrieved) {
+                for (const auto& candidate : candidates) {
+                    auto& ids = authors[index->file(candidate.id).submission];
+                    if (std::find(ids.begin(), ids.end(), candidate.id) == ids.end()) {
+                        ids.push_back(candidate.id);
                     }
+                }
+            }
 
-                    if (confidence == 0.0) {
-                        return;
-                    }
+            for (const auto& [author, ids] : authors) {
+                std::vector<contents::Content> rhs_contents;
+                std::vector<std::string> rhs_labels;
+
+                for (auto id : ids) {
+                    auto file = index->file(id);
+                    rhs_contents.push_back(contents::prepare(file.path, index->text(id)));
+                    rhs_labels.push_back(file.path);
+                }
+
+                matrices::Dense matrix(lhs_files.size(), ids.size(), alpha_threshold);
 
-                    std::lock_guard lock(docmutex);
+                for (std::size_t lidx = 0; lidx < lhs_files.size(); ++lidx) {
+                    for (const auto& candidate : retrieved[lidx]) {
+                        auto ridx = std::find(ids.begin(), ids.end(), candidate.id) - ids.begin();
+                        if (ridx == static_cast<std::ptrdiff_t>(ids.size())) {
+                            continue;
+                        }
 
-                    auto cheated = rapidjson::build::string(
-                        std::filesystem::relative(lhs, lhs_path).string(),
-                        summary.GetAllocator());
+                        auto task = pool.submit_task([&, lidx, ridx]{
+                            const auto& lhs = contents.load(lhs_files[lidx]);
 
-                    rapidjson::Value sources(rapidjson::kArrayType);
-                    for (const auto& rhs : suspects) {
-                        auto source = rapidjson::build::string(
-                            std::filesystem::relative(rhs, rhs_path).string(),
-                            summary.GetAllocator());
-                        sources.PushBack(source, summary.GetAllocator());
+                            if (scorer.compatible(lhs, rhs_contents[ridx])) {
+                                matrix.set(lidx, ridx, scorer.estimate(lhs, rhs_contents[ridx]));
+                            }
+                        });
                     }
+                }
 
-                    rapidjson::Value matching;
-                    matching.SetObject();
+                pool.wait();
 
-                    matching.AddMember("cheated", cheated, summary.GetAllocator());
-                    matching.AddMember("confidence", confidence, summary.GetAllocator());
-                    matching.AddMember("sources", sources, summary.GetAllocator());
+                comment(name, author, labels[name], rhs_labels, matrices::Sparse(matrix));
 
-                    matchings.PushBack(matching, summary.GetAllocator());
-                });
+                if (archive) {
+                    persist(name, author, labels[name], rhs_labels, matrix);
+                }
             }
+        }
 
-            pool.wait();
+        if (extend_corpus) {
+            for (const auto& submission : execflow["submissions"].GetArray()) {
+                std::string name = submission["name"].GetString();
+                const auto& submission_files = files[name];
 
-            if (matchings.Empty()) {
-                continue;
+                for (std::size_t idx = 0; idx < submission_files.size(); ++idx) {
+                    const auto& content = contents.load(submission_files[idx]);
+                    index->add(std::format("{}/{}", corpus_label, name), labels[name][idx], content.text);
+                }
             }
 
-            auto comparator = [](const rapidjson::Value& lhs, const rapidjson::Value& rhs) {
-                return lhs["confidence"].GetDouble() > rhs["confidence"].GetDouble();
-            };
-            std::sort(matchings.Begin(), matchings.End(), comparator);
+            index->commit();
+        }
+    }
+
+    documents::execflow::parallel::rmtree(execflow, threads);
+
+    if (archive) {
+        try {
+            archive->commit();
+        }
+        catch (const std::exception& exc) {
+            logging::error(exc.what());
+            return EXIT_FAILURE;
+        }
+
+        auto detail = std::format(
+            "The score matrices are available at {}",
+            std::filesystem::weakly_canonical(cli.get<std::string>("save-matrices")).string());
+        logging::info(detail);
+    }
+
+    try {
+        summary->close();
+    }
+    catch (const std::exception& exc) {
+        logging::error(exc.what());
+        return EXIT_FAILURE;
+    }
+
+    auto detail = std::format(
+        "The summary is available at {}",
+        std::filesystem::weakly_canonical(path_to_output).string());
+    logging::info(detail);
 
-            rapidjson::Value comments;
-            comments.SetObject();
+    report::buffer::storage.push_back(std::format(
+        "The {} kernels were used",
+        kernels::name(kernels::active())));
 
-            comments.AddMember("submissions", submissions, summary.GetAllocator());
-            comments.AddMember("matchings", matchings, summary.GetAllocator());
+    auto counters = scorer.statistics();
 
-            summary["summary"].PushBack(comments, summary.GetAllocator());
+    if (explain) {
+        for (const auto& line : scorer.explain()) {
+            report::buffer::storage.push_back(line);
         }
     }
 
-    documents::execflow::parallel::rmtree(execflow, threads);
+    if (best_first) {
+        report::buffer::storage.push_back(std::format(
+            "The best-first matching left {} file pairs unevaluated",
+            counters.deferred));
+    }
 
-    auto path_to_summary = documents::summary::write_json(summary);
-    std::filesystem::path output = path_to_summary;
+    if (approximate) {
+        report::buffer::storage.push_back(std::format(
+            "The approximate mode verified {} file pairs exactly",
+            counters.verified));
+    }
 
-    if (cli.is_used("output")) {
-        output = cli.get<std::string>("output");
+    if (scorer.batched()) {
+        report::buffer::storage.push_back(std::format(
+            "The batched Levenshtein kernel was invoked {} times",
+            counters.batches));
     }
 
-    if (std::filesystem::exists(output) && !std::filesystem::is_regular_file(output)) {
-        logging::warning(std::format(
-            "The output path {} is not writable",
-            output.string()));
-        logging::newline();
+    report::buffer::storage.push_back(std::format(
+        "The sketch gate skipped {} submission pairs",
+        gated));
+
+    report::buffer::storage.push_back(std::format(
+        "The language buckets skipped {} incompatible file pairs",
+        counters.incompatible));
+
+    report::buffer::storage.push_back(std::format(
+        "Identical files skipped {} comparisons",
+        counters.duplicates));
 
-        output = path_to_summary;
+    report::buffer::storage.push_back(std::format(
+        "Twin submissions reused {} matrices",
+        reused));
 
-    } else if (output != path_to_summary) {
-        std::filesystem::copy_file(path_to_summary, output);
-        std::filesystem::remove(path_to_summary);
+    report::buffer::storage.push_back(std::format(
+        "The sparse matrices kept {} of {} file pairs",
+        kept,
+        pairs));
+
+    if (use_lsh) {
+        report::buffer::storage.push_back(std::format(
+            "The LSH index pruned {} of {} file pairs",
+            counters.pruned,
+            pairs));
     }
 
-    auto detail = std::format(
-        "The summary is available at {}",
-        std::filesystem::weakly_canonical(output).string());
-    logging::info(detail);
+    if (prefilter) {
+        report::buffer::storage.push_back(std::format(
+            "The prefilter skipped {} comparisons",
+            counters.prefiltered));
+    }
+
+    if (!disable_cache) {
+        auto statistics = scorecache::statistics();
+        report::buffer::storage.push_back(std::format(
+            "The score cache served {} of {} comparisons",
+            statistics.hits,
+            statistics.hits + statistics.misses));
+    }
+
+    report::buffer::flush();
 
     timer.finish();
     logging::trace(timer);
@@ -29,18 +29,70 @@
 
 #include "lib/pathlib/pathlib.hpp"
 
-rapidjson::Document adapters::to_rapidjson::read_yaml(const std::filesystem::path& path) {
-    YAML::Emitter emitter;
+namespace __adapters::to_rapidjson::core {
 
-    emitter << YAML::DoubleQuoted << YAML::Flow << YAML::BeginSeq
-        << YAML::Load(pathlib::read_text(path));
+/* The scalars stay strings, the readers type them by their own schemas */
+rapidjson::Value scalar(const YAML::Node& node, rapidjson::Document::AllocatorType& allocator) {
+    const auto& text = node.Scalar();
 
-    rapidjson::Document workflow;
+    rapidjson::Value value;
+    value.SetString(text.data(), static_cast<rapidjson::SizeType>(text.size()), allocator);
+
+    return value;
+}
+
+rapidjson::Value convert(const YAML::Node& node, rapidjson::Document::AllocatorType& allocator) {
+    switch (node.Type()) {
+        case YAML::NodeType::Scalar:
+            return scalar(node, allocator);
+
+        case YAML::NodeType::Sequence: {
+            rapidjson::Value array(rapidjson::kArrayType);
+
+            for (const auto& item : node) {
+                array.PushBack(convert(item, allocator), allocator);
+            }
+
+            return array;
+        }
+
+        case YAML::NodeType::Map: {
+            rapidjson::Value object(rapidjson::kObjectType);
+
+            for (const auto& item : node) {
+                const auto& key = item.first.Scalar();
+
+                rapidjson::Value name;
+                name.SetString(key.data(), static_cast<rapidjson::SizeType>(key.size()), allocator);
+
+                object.AddMember(name, convert(item.second, allocator), allocator);
+            }
 
-    if (workflow.Parse<0>(emitter.c_str() + 1).HasParseError()) {
+            return object;
+        }
+
+        default:
+            return rapidjson::Value(rapidjson::kNullType);
+    }
+}
+
+}  // namespace __adapters::to_rapidjson::core
+
+rapidjson::Document adapters::to_rapidjson::read_yaml(const std::filesystem::path& path) {
+    YAML::Node root;
+
+    try {
+        root = YAML::Load(pathlib::read_text(path));
+    }
+    catch (const YAML::Exception&) {
         auto detail = std::format("The path {} contains an invalid YAML document", path.string());
         throw std::runtime_error(detail);
     }
 
+    rapidjson::Document workflow;
+
+    auto value = __adapters::to_rapidjson::core::convert(root, workflow.GetAllocator());
+    static_cast<rapidjson::Value&>(workflow).Swap(value);
+
     return workflow;
 }
@@ -33,6 +33,8 @@ namespace adapters::to_rapidjson {
  * 
  * @param path the path to the `YAML` file
  * @return the document from the parsed file
+ * 
+ * @note every scalar is read as a string, as `YAML` does not fix their types
 */
 rapidjson::Document read_yaml(const std::filesystem::path& path);
 
@@ -0,0 +1,236 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lib/compression/compression.hpp"
+
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+#include <zlib.h>
+#include <zstd.h>
+
+namespace __compression::mode {
+
+constexpr int proceed = 0;
+constexpr int flush = 1;
+constexpr int finish = 2;
+
+}  // namespace __compression::mode
+
+namespace __compression::gzip {
+
+/* The window bits of `zlib` with the `gzip` header and trailer */
+constexpr int window = 15 + 16;
+constexpr int memory = 8;
+
+constexpr std::size_t buffer = 1 << 16;
+
+}  // namespace __compression::gzip
+
+namespace compression {
+
+std::string name(Codec codec) {
+    switch (codec) {
+        case Codec::none:
+            return "none";
+        case Codec::gzip:
+            return "gzip";
+        case Codec::zstd:
+            return "zstd";
+    }
+
+    constexpr auto detail = "Unknown codec";
+    throw std::runtime_error(detail);
+}
+
+Codec parse(const std::string& name) {
+    for (auto codec : {Codec::none, Codec::gzip, Codec::zstd}) {
+        if (compression::name(codec) == name) {
+            return codec;
+        }
+    }
+
+    auto detail = std::format("Unknown codec '{}'", name);
+    throw std::runtime_error(detail);
+}
+
+Writer::Writer(const std::filesystem::path& path, Codec codec)
+    : path_(path), codec_(codec), stream_(path, std::ios::binary | std::ios::trunc) {
+    if (!this->stream_.is_open()) {
+        auto detail = std::format("Failed to open the file {}", path.string());
+        throw std::runtime_error(detail);
+    }
+
+    auto detail = std::format("Failed to start the {} stream", compression::name(codec));
+
+    if (codec == Codec::gzip) {
+        auto stream = new z_stream{};
+
+        auto status = deflateInit2(
+            stream,
+            Z_DEFAULT_COMPRESSION,
+            Z_DEFLATED,
+            __compression::gzip::window,
+            __compression::gzip::memory,
+            Z_DEFAULT_STRATEGY);
+
+        if (status != Z_OK) {
+            delete stream;
+            throw std::runtime_error(detail);
+        }
+
+        this->state_ = stream;
+        this->buffer_.resize(__compression::gzip::buffer);
+    }
+
+    if (codec == Codec::zstd) {
+        auto context = ZSTD_createCCtx();
+
+        if (context == nullptr) {
+            throw std::runtime_error(detail);
+        }
+
+        auto status = ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+
+        if (ZSTD_isError(status)) {
+            ZSTD_freeCCtx(context);
+            throw std::runtime_error(detail);
+        }
+
+        this->state_ = context;
+        this->buffer_.resize(ZSTD_CStreamOutSize());
+    }
+}
+
+Writer::~Writer() {
+    if (this->state_ == nullptr) {
+        return;
+    }
+
+    if (this->codec_ == Codec::gzip) {
+        auto stream = static_cast<z_stream*>(this->state_);
+        deflateEnd(stream);
+        delete stream;
+    }
+
+    if (this->codec_ == Codec::zstd) {
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(this->state_));
+    }
+}
+
+void Writer::write(std::string_view data) {
+    if (this->codec_ == Codec::none) {
+        this->stream_.write(data.data(), data.size());
+    } else {
+        this->pump(data, __compression::mode::proceed);
+    }
+
+    this->check();
+}
+
+void Writer::flush(void) {
+    if (this->codec_ == Codec::none) {
+        this->stream_.flush();
+    } else {
+        this->pump({}, __compression::mode::flush);
+        this->stream_.flush();
+    }
+
+    this->check();
+}
+
+void Writer::close(void) {
+    if (this->codec_ != Codec::none) {
+        this->pump({}, __compression::mode::finish);
+    }
+
+    this->stream_.close();
+    this->check();
+}
+
+void Writer::pump(std::string_view data, int mode) {
+    auto detail = std::format("Failed to compress the file {}", this->path_.string());
+
+    if (this->codec_ == Codec::gzip) {
+        auto stream = static_cast<z_stream*>(this->state_);
+
+        auto flush = mode == __compression::mode::proceed ? Z_NO_FLUSH
+            : mode == __compression::mode::flush ? Z_SYNC_FLUSH
+            : Z_FINISH;
+
+        /* The input length of `zlib` is 32-bit */
+        do {
+            auto chunk = std::min<std::size_t>(data.size(), std::numeric_limits<uInt>::max());
+
+            stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+            stream->avail_in = static_cast<uInt>(chunk);
+            data.remove_prefix(chunk);
+
+            auto directive = data.empty() ? flush : Z_NO_FLUSH;
+
+            do {
+                stream->next_out = reinterpret_cast<Bytef*>(this->buffer_.data());
+                stream->avail_out = static_cast<uInt>(this->buffer_.size());
+
+                if (deflate(stream, directive) == Z_STREAM_ERROR) {
+                    throw std::runtime_error(detail);
+                }
+
+                this->stream_.write(this->buffer_.data(), this->buffer_.size() - stream->avail_out);
+            } while (stream->avail_out == 0);
+        } while (!data.empty());
+    }
+
+    if (this->codec_ == Codec::zstd) {
+        auto context = static_cast<ZSTD_CCtx*>(this->state_);
+
+        auto directive = mode == __compression::mode::proceed ? ZSTD_e_continue
+            : mode == __compression::mode::flush ? ZSTD_e_flush
+            : ZSTD_e_end;
+
+        ZSTD_inBuffer input{data.data(), data.size(), 0};
+        bool done = false;
+
+        while (!done) {
+            ZSTD_outBuffer output{this->buffer_.data(), this->buffer_.size(), 0};
+
+            auto remaining = ZSTD_compressStream2(context, &output, &input, directive);
+            if (ZSTD_isError(remaining)) {
+                throw std::runtime_error(detail);
+            }
+
+            this->stream_.write(this->buffer_.data(), output.pos);
+
+            done = directive == ZSTD_e_continue ? input.pos == input.size : remaining == 0;
+        }
+    }
+}
+
+void Writer::check(void) {
+    if (!this->stream_) {
+        auto detail = std::format("Failed to write the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+}
+
+}  // namespace compression
@@ -0,0 +1,112 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIB_COMPRESSION_COMPRESSION_HPP_
+#define LIB_COMPRESSION_COMPRESSION_HPP_
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace compression {
+
+/**
+ * Compression of a file.
+*/
+enum class Codec {
+    none,
+    gzip,
+    zstd,
+};
+
+/**
+ * Returns the name of the codec.
+ * 
+ * @param codec the codec
+ * @return the name, e.g. `gzip`
+*/
+std::string name(Codec codec);
+
+/**
+ * Parses the name of the codec.
+ * 
+ * @param name the name, e.g. `gzip`
+ * @return the codec
+*/
+Codec parse(const std::string& name);
+
+/**
+ * Writes a file through the codec.
+ * 
+ * @note the file is complete only when closed
+*/
+class Writer {
+ public:
+    /**
+     * Opens the file.
+     * 
+     * @param path the path to the file
+     * @param codec the codec
+    */
+    Writer(const std::filesystem::path& path, Codec codec);
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    ~Writer();
+
+    /**
+     * Compresses the bytes.
+     * 
+     * @param data the bytes
+    */
+    void write(std::string_view data);
+
+    /**
+     * Makes the bytes written so far decodable from the file.
+     * 
+     * @note each flush slightly worsens the compression
+    */
+    void flush(void);
+
+    /**
+     * Finishes the stream and closes the file.
+    */
+    void close(void);
+
+ private:
+    std::filesystem::path path_;
+    Codec codec_;
+
+    std::ofstream stream_;
+    std::vector<char> buffer_;
+
+    void* state_ = nullptr;
+
+    void pump(std::string_view data, int mode);
+    void check(void);
+};
+
+}  // namespace compression
+
+#endif  // LIB_COMPRESSION_COMPRESSION_HPP_
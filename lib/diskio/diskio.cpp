@@ -0,0 +1,149 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lib/diskio/diskio.hpp"
+
+#include <cerrno>
+#include <format>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace __diskio::lock {
+
+#ifdef _WIN32
+/* The locked range lies beyond any contents, so the file stays readable */
+constexpr DWORD offset = 0xFFFFFFFF;
+#endif
+
+}  // namespace __diskio::lock
+
+void diskio::sync(const std::filesystem::path& path) {
+    auto detail = std::format("Failed to sync the path {}", path.string());
+
+#ifdef _WIN32
+    if (std::filesystem::is_directory(path)) {
+        return;
+    }
+
+    auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(detail);
+    }
+
+    auto flushed = FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (!flushed) {
+        throw std::runtime_error(detail);
+    }
+#else
+    auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error(detail);
+    }
+
+    auto status = ::fsync(descriptor);
+    ::close(descriptor);
+
+    if (status != 0) {
+        throw std::runtime_error(detail);
+    }
+#endif
+}
+
+namespace diskio {
+
+Lock::Lock(const std::filesystem::path& path) {
+    auto detail = std::format("Failed to lock the file {}", path.string());
+
+#ifdef _WIN32
+    auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(detail);
+    }
+
+    OVERLAPPED overlapped{};
+    overlapped.Offset = __diskio::lock::offset;
+
+    if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) {
+        CloseHandle(file);
+        throw std::runtime_error(detail);
+    }
+
+    this->handle_ = file;
+#else
+    auto descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descriptor < 0) {
+        throw std::runtime_error(detail);
+    }
+
+    /* Interrupted waits are resumed */
+    int status;
+    do {
+        status = ::flock(descriptor, LOCK_EX);
+    } while (status != 0 && errno == EINTR);
+
+    if (status != 0) {
+        ::close(descriptor);
+        throw std::runtime_error(detail);
+    }
+
+    this->descriptor_ = descriptor;
+#endif
+}
+
+Lock::~Lock() {
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    overlapped.Offset = __diskio::lock::offset;
+
+    UnlockFileEx(this->handle_, 0, 1, 0, &overlapped);
+    CloseHandle(this->handle_);
+#else
+    ::flock(this->descriptor_, LOCK_UN);
+    ::close(this->descriptor_);
+#endif
+}
+
+}  // namespace diskio
@@ -0,0 +1,67 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIB_DISKIO_DISKIO_HPP_
+#define LIB_DISKIO_DISKIO_HPP_
+
+#include <filesystem>
+
+namespace diskio {
+
+/**
+ * Flushes the file or the directory from the system caches to the disk.
+ * 
+ * @param path the path to the file or the directory
+ * 
+ * @note directories are flushed only on POSIX systems
+*/
+void sync(const std::filesystem::path& path);
+
+/**
+ * Exclusive advisory lock of a file, shared by all processes.
+ * 
+ * @note the lock is acquired on construction, waiting for other holders if necessary
+ * @note the lock is released on destruction
+ * @note the lock file is created if it does not exist, its contents are left intact
+*/
+class Lock {
+ public:
+    /**
+     * Acquires the lock.
+     * 
+     * @param path the path to the lock file
+    */
+    explicit Lock(const std::filesystem::path& path);
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+
+    ~Lock();
+
+ private:
+    int descriptor_ = -1;
+
+    void* handle_ = nullptr;
+};
+
+}  // namespace diskio
+
+#endif  // LIB_DISKIO_DISKIO_HPP_
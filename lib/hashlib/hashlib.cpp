@@ -0,0 +1,139 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lib/hashlib/hashlib.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace __hashlib::sha256 {
+
+constexpr std::array<std::uint32_t, 64> constants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr std::uint32_t rotr(std::uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+void compress(std::array<std::uint32_t, 8>& state, const unsigned char* block) {
+    std::array<std::uint32_t, 64> w;
+
+    for (std::size_t idx = 0; idx < 16; ++idx) {
+        w[idx] = (static_cast<std::uint32_t>(block[4 * idx]) << 24)
+               | (static_cast<std::uint32_t>(block[4 * idx + 1]) << 16)
+               | (static_cast<std::uint32_t>(block[4 * idx + 2]) << 8)
+               | (static_cast<std::uint32_t>(block[4 * idx + 3]));
+    }
+
+    for (std::size_t idx = 16; idx < 64; ++idx) {
+        auto s0 = rotr(w[idx - 15], 7) ^ rotr(w[idx - 15], 18) ^ (w[idx - 15] >> 3);
+        auto s1 = rotr(w[idx - 2], 17) ^ rotr(w[idx - 2], 19) ^ (w[idx - 2] >> 10);
+        w[idx] = w[idx - 16] + s0 + w[idx - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = state;
+
+    for (std::size_t idx = 0; idx < 64; ++idx) {
+        auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        auto ch = (e & f) ^ (~e & g);
+        auto t1 = h + s1 + ch + constants[idx] + w[idx];
+        auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        auto maj = (a & b) ^ (a & c) ^ (b & c);
+        auto t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+}  // namespace __hashlib::sha256
+
+std::string hashlib::sha256(const std::string& data) {
+    std::array<std::uint32_t, 8> state = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    auto size = data.size();
+
+    std::size_t offset = 0;
+    for (; offset + 64 <= size; offset += 64) {
+        __hashlib::sha256::compress(state, bytes + offset);
+    }
+
+    /* The padding takes either one or two final blocks */
+    std::array<unsigned char, 128> tail{};
+    auto remainder = size - offset;
+
+    for (std::size_t idx = 0; idx < remainder; ++idx) {
+        tail[idx] = bytes[offset + idx];
+    }
+    tail[remainder] = 0x80;
+
+    std::size_t blocks = (remainder + 1 + 8 <= 64) ? 1 : 2;
+    std::uint64_t bits = static_cast<std::uint64_t>(size) * 8;
+
+    for (std::size_t idx = 0; idx < 8; ++idx) {
+        tail[64 * blocks - 1 - idx] = static_cast<unsigned char>(bits >> (8 * idx));
+    }
+
+    for (std::size_t block = 0; block < blocks; ++block) {
+        __hashlib::sha256::compress(state, tail.data() + 64 * block);
+    }
+
+    constexpr auto alphabet = "0123456789abcdef";
+
+    std::string digest;
+    digest.reserve(64);
+
+    for (auto word : state) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            digest.push_back(alphabet[(word >> shift) & 0xF]);
+        }
+    }
+
+    return digest;
+}
@@ -0,0 +1,117 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lib/memmap/memmap.hpp"
+
+#include <format>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace memmap {
+
+File::File(const std::filesystem::path& path) {
+    if (!std::filesystem::is_regular_file(path)) {
+        auto detail = std::format("The path {} is not a regular file", path.string());
+        throw std::runtime_error(detail);
+    }
+
+    this->size_ = std::filesystem::file_size(path);
+    if (this->size_ == 0) {
+        return;
+    }
+
+    auto detail = std::format("Failed to map the file {}", path.string());
+
+#ifdef _WIN32
+    auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(detail);
+    }
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (mapping == nullptr) {
+        throw std::runtime_error(detail);
+    }
+
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        throw std::runtime_error(detail);
+    }
+
+    this->handle_ = mapping;
+    this->data_ = static_cast<const char*>(view);
+#else
+    auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error(detail);
+    }
+
+    auto view = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (view == MAP_FAILED) {
+        throw std::runtime_error(detail);
+    }
+
+    this->data_ = static_cast<const char*>(view);
+#endif
+}
+
+File::~File() {
+    if (this->data_ == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(this->data_);
+    CloseHandle(this->handle_);
+#else
+    ::munmap(const_cast<char*>(this->data_), this->size_);
+#endif
+}
+
+const char* File::data(void) const {
+    return this->data_;
+}
+
+std::size_t File::size(void) const {
+    return this->size_;
+}
+
+}  // namespace memmap
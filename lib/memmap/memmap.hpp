@@ -0,0 +1,73 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIB_MEMMAP_MEMMAP_HPP_
+#define LIB_MEMMAP_MEMMAP_HPP_
+
+#include <cstddef>
+#include <filesystem>
+
+namespace memmap {
+
+/**
+ * Read-only memory mapping of a regular file.
+ * 
+ * @note the mapping is released on destruction
+ * @note empty files are represented by an empty mapping
+*/
+class File {
+ public:
+    /**
+     * Maps the file into memory.
+     * 
+     * @param path the path to the file
+    */
+    explicit File(const std::filesystem::path& path);
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    ~File();
+
+    /**
+     * Gets the beginning of the mapped bytes.
+     * 
+     * @return the pointer to the first byte
+    */
+    const char* data(void) const;
+
+    /**
+     * Gets the number of the mapped bytes.
+     * 
+     * @return the size of the file
+    */
+    std::size_t size(void) const;
+
+ private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    void* handle_ = nullptr;
+};
+
+}  // namespace memmap
+
+#endif  // LIB_MEMMAP_MEMMAP_HPP_
@@ -24,8 +24,138 @@
 #include <format>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 
+namespace __pathlib::glob {
+
+/* Returns the length of the bracket expression, zero if it is not closed */
+std::size_t bracket(std::string_view pattern) {
+    std::size_t idx = 1;
+
+    if (idx < pattern.size() && (pattern[idx] == '!' || pattern[idx] == '^')) {
+        idx += 1;
+    }
+
+    /* The first `]` is a member of the class */
+    if (idx < pattern.size() && pattern[idx] == ']') {
+        idx += 1;
+    }
+
+    while (idx < pattern.size() && pattern[idx] != ']') {
+        idx += 1;
+    }
+
+    return (idx < pattern.size()) ? idx + 1 : 0;
+}
+
+bool member(std::string_view expression, char symbol) {
+    /* Without the brackets */
+    auto body = expression.substr(1, expression.size() - 2);
+
+    bool negated = !body.empty() && (body[0] == '!' || body[0] == '^');
+    if (negated) {
+        body.remove_prefix(1);
+    }
+
+    bool found = false;
+
+    for (std::size_t idx = 0; idx < body.size(); ++idx) {
+        if (idx + 2 < body.size() && body[idx + 1] == '-') {
+            found = found || (body[idx] <= symbol && symbol <= body[idx + 2]);
+            idx += 2;
+        } else {
+            found = found || body[idx] == symbol;
+        }
+    }
+
+    return found != negated;
+}
+
+bool match(std::string_view pattern, std::string_view text) {
+    while (!pattern.empty()) {
+        if (pattern.starts_with("**")) {
+            auto rest = pattern.substr(2);
+
+            /* A double star before a slash stands for zero or more whole directories */
+            if (rest.starts_with('/')) {
+                rest.remove_prefix(1);
+
+                for (std::size_t idx = 0; idx <= text.size(); ++idx) {
+                    if ((idx == 0 || text[idx - 1] == '/') && match(rest, text.substr(idx))) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            for (std::size_t idx = 0; idx <= text.size(); ++idx) {
+                if (match(rest, text.substr(idx))) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        if (pattern[0] == '*') {
+            auto rest = pattern.substr(1);
+
+            for (std::size_t idx = 0;; ++idx) {
+                if (match(rest, text.substr(idx))) {
+                    return true;
+                }
+
+                if (idx == text.size() || text[idx] == '/') {
+                    return false;
+                }
+            }
+        }
+
+        if (text.empty()) {
+            return false;
+        }
+
+        if (pattern[0] == '?') {
+            if (text[0] == '/') {
+                return false;
+            }
+        } else if (auto length = (pattern[0] == '[') ? bracket(pattern) : 0; length != 0) {
+            if (text[0] == '/' || !member(pattern.substr(0, length), text[0])) {
+                return false;
+            }
+
+            pattern.remove_prefix(length);
+            text.remove_prefix(1);
+            continue;
+        } else if (pattern[0] != text[0]) {
+            return false;
+        }
+
+        pattern.remove_prefix(1);
+        text.remove_prefix(1);
+    }
+
+    return text.empty();
+}
+
+}  // namespace __pathlib::glob
+
+bool pathlib::match(const std::filesystem::path& path, const std::string& pattern) {
+    std::string_view view(pattern);
+
+    if (view.find('/') == std::string_view::npos) {
+        return __pathlib::glob::match(view, path.filename().generic_string());
+    }
+
+    if (view.starts_with('/')) {
+        view.remove_prefix(1);
+    }
+
+    return __pathlib::glob::match(view, path.generic_string());
+}
+
 std::string pathlib::read_text(const std::filesystem::path& path) {
     if (!std::filesystem::exists(path)) {
         auto detail = std::format("The path {} does not exist", path.string());
@@ -46,3 +176,19 @@ std::string pathlib::read_text(const std::filesystem::path& path) {
 
     return {std::istreambuf_iterator<char>{stream}, {}};
 }
+
+void pathlib::write_text(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream stream(path, std::ios::trunc);
+
+    if (!stream.is_open()) {
+        auto detail = std::format("Failed to open the path {}", path.string());
+        throw std::runtime_error(detail);
+    }
+
+    stream << text;
+
+    if (!stream) {
+        auto detail = std::format("Failed to write the path {}", path.string());
+        throw std::runtime_error(detail);
+    }
+}
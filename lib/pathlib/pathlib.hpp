@@ -27,6 +27,18 @@
 
 namespace pathlib {
 
+/**
+ * Checks whether the relative path matches the glob pattern.
+ * 
+ * @param path the relative path
+ * @param pattern the glob pattern
+ * @return if the path matches the pattern
+ * 
+ * @note supports `*`, `?`, `[...]` and `**` for any number of directories
+ * @note patterns without a slash are matched against the last component only
+*/
+bool match(const std::filesystem::path& path, const std::string& pattern);
+
 /**
  * Reads the contents of a regular file.
  * 
@@ -35,6 +47,16 @@ namespace pathlib {
 */
 std::string read_text(const std::filesystem::path& path);
 
+/**
+ * Replaces the contents of a regular file.
+ * 
+ * @param path the path to the file
+ * @param text the contents to be written
+ * 
+ * @note the file is created if it does not exist
+*/
+void write_text(const std::filesystem::path& path, const std::string& text);
+
 }  // namespace pathlib
 
 #endif  // LIB_PATHLIB_PATHLIB_HPP_
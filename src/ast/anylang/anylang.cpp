@@ -44,3 +44,15 @@ std::filesystem::path ast::anylang::normalize(const std::filesystem::path& path,
 
     return destination;
 }
+
+std::string ast::anylang::language(const std::filesystem::path& path) {
+    if (ast::starlark::isinstance(path)) {
+        return "starlark";
+    }
+
+    if (ast::python::isinstance(path)) {
+        return "python";
+    }
+
+    return "";
+}
@@ -23,9 +23,17 @@
 #define SRC_AST_ANYLANG_ANYLANG_HPP_
 
 #include <filesystem>
+#include <string>
 
 namespace ast::anylang {
 
+/**
+ * The revision of the normalization rules.
+ * 
+ * @note must be changed whenever the output of `normalize` changes
+*/
+constexpr const char* version = "G001+G002";
+
 /**
  * Normalizes the abstract syntax tree of any language according to the `gelada` rules.
  * 
@@ -38,6 +46,16 @@ namespace ast::anylang {
 */
 std::filesystem::path normalize(const std::filesystem::path& path, bool inplace = false);
 
+/**
+ * Detects the language of the abstract syntax tree in the file.
+ * 
+ * @param path the path to the file
+ * @return `starlark`, `python` or an empty string if neither
+ * 
+ * @note uses the `Python` interpreter
+*/
+std::string language(const std::filesystem::path& path);
+
 }  // namespace ast::anylang
 
 #endif  // SRC_AST_ANYLANG_ANYLANG_HPP_
@@ -22,6 +22,7 @@
 #include "src/ast/python/python.hpp"
 
 #include <exception>
+#include <sstream>
 #include <string>
 
 #include <experimental/embed>
@@ -75,3 +76,29 @@ std::filesystem::path ast::python::normalize(const std::filesystem::path& path,
 
     return destination;
 }
+
+std::vector<ast::python::Span> ast::python::units(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+        throw errors::filesystem::FileNotFoundError(path);
+    }
+
+    if (!std::filesystem::is_regular_file(path)) {
+        throw errors::filesystem::NotAFileError(path);
+    }
+
+    std::string script = std::embed("src/ast/python/units.py");
+    pylada::arg(script, "PATH", path.string());
+
+    std::vector<ast::python::Span> spans;
+
+    std::stringstream stream(pylada::run(script));
+    std::string span;
+
+    /* Formatted as `first-last,first-last` */
+    while (std::getline(stream, span, ',')) {
+        auto dash = span.find('-');
+        spans.push_back({std::stoul(span.substr(0, dash)), std::stoul(span.substr(dash + 1))});
+    }
+
+    return spans;
+}
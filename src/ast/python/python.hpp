@@ -22,10 +22,23 @@
 #ifndef SRC_AST_PYTHON_PYTHON_HPP_
 #define SRC_AST_PYTHON_PYTHON_HPP_
 
+#include <cstddef>
 #include <filesystem>
+#include <vector>
 
 namespace ast::python {
 
+/**
+ * Lines of a code unit.
+ * 
+ * @param first the first line, starting from one
+ * @param last the last line, inclusive
+*/
+struct Span {
+    std::size_t first;
+    std::size_t last;
+};
+
 /**
  * Checks whether the file contains a valid node of the `Python` abstract syntax tree.
  * 
@@ -47,6 +60,17 @@ bool isinstance(const std::filesystem::path& path);
 */
 std::filesystem::path normalize(const std::filesystem::path& path, bool inplace = false);
 
+/**
+ * Finds the top-level functions and the methods of the top-level classes.
+ * 
+ * @param path the path to the file
+ * @return the spans of the units in order
+ * 
+ * @note uses the `Python` interpreter
+ * @note decorators belong to the unit
+*/
+std::vector<Span> units(const std::filesystem::path& path);
+
 }  // namespace ast::python
 
 #endif  // SRC_AST_PYTHON_PYTHON_HPP_
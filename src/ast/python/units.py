@@ -0,0 +1,79 @@
+"""
+ ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+ ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+
+Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import ast
+
+from pathlib import Path
+
+
+EXIT_SUCCESS: int = 0
+EXIT_FAILURE: int = 1
+
+
+AnyFunctionDef = ast.AsyncFunctionDef | ast.FunctionDef
+
+
+def main() -> tuple[int, str]:
+    """
+    Finds the functions and the methods of the Python code.
+
+    Pylada Args:
+        `PATH`: the path to the input file
+
+    Returns:
+        the comma-separated line spans of the units, e.g. `"1-4,6-10"`
+    """
+    path = Path(r"%PATH%")
+
+    text = path.read_text(
+        encoding="utf-8",
+        errors="replace",
+    )
+
+    try:
+        tree = ast.parse(text, path)
+
+    except Exception:
+        detail = "The text is not a valid Python code"
+        return (EXIT_FAILURE, detail)
+
+    spans: list[str] = []
+
+    for node in tree.body:
+        nodes = node.body if isinstance(node, ast.ClassDef) else [node]
+
+        for unit in nodes:
+            if not isinstance(unit, AnyFunctionDef):
+                continue
+
+            first = min([
+                unit.lineno,
+                *[
+                    decorator.lineno
+                    for decorator in unit.decorator_list
+                ],
+            ])
+
+            spans.append(f"{first}-{unit.end_lineno}")
+
+    return (EXIT_SUCCESS, ",".join(spans))
@@ -0,0 +1,151 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/boilerplate/boilerplate.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace __boilerplate::lines {
+
+struct Line {
+    std::string_view text;
+    std::uint64_t hash;
+    bool blank;
+};
+
+/* FNV-1a of the trimmed line */
+std::uint64_t hash(std::string_view line) {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for (auto symbol : line) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+std::vector<Line> split(const std::string& text) {
+    std::vector<Line> lines;
+    std::string_view view(text);
+
+    for (std::size_t start = 0; start < view.size();) {
+        auto end = view.find('\n', start);
+        end = (end == std::string_view::npos) ? view.size() : end;
+
+        auto line = view.substr(start, end - start);
+
+        auto first = line.find_first_not_of(" \t\r\f\v");
+        auto blank = first == std::string_view::npos;
+
+        auto trimmed = blank
+            ? std::string_view{}
+            : line.substr(first, line.find_last_not_of(" \t\r\f\v") - first + 1);
+
+        lines.push_back({line, hash(trimmed), blank});
+        start = end + 1;
+    }
+
+    return lines;
+}
+
+/* Calls the visitor with the hash and the indices of the lines of every shingle */
+template <typename Visitor>
+void shingle(const std::vector<Line>& lines, std::size_t k, Visitor visitor) {
+    if (k == 0) {
+        constexpr auto detail = "The number of lines per shingle must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    std::vector<std::size_t> significant;
+    for (std::size_t idx = 0; idx < lines.size(); ++idx) {
+        if (!lines[idx].blank) {
+            significant.push_back(idx);
+        }
+    }
+
+    if (significant.empty()) {
+        return;
+    }
+
+    auto width = std::min(k, significant.size());
+
+    for (std::size_t start = 0; start + width <= significant.size(); ++start) {
+        std::uint64_t hash = width;
+
+        for (std::size_t offset = 0; offset < width; ++offset) {
+            hash = (hash ^ lines[significant[start + offset]].hash) * 0x100000001B3ULL;
+        }
+
+        visitor(hash, significant.begin() + start, significant.begin() + start + width);
+    }
+}
+
+}  // namespace __boilerplate::lines
+
+std::unordered_set<std::uint64_t> boilerplate::shingles(const std::string& text, std::size_t k) {
+    std::unordered_set<std::uint64_t> hashes;
+
+    auto lines = __boilerplate::lines::split(text);
+    __boilerplate::lines::shingle(lines, k, [&](std::uint64_t hash, auto, auto) {
+        hashes.insert(hash);
+    });
+
+    return hashes;
+}
+
+std::string boilerplate::strip(
+    const std::string& text,
+    const std::unordered_set<std::uint64_t>& boilerplate,
+    std::size_t& removed,
+    std::size_t k
+) {
+    auto lines = __boilerplate::lines::split(text);
+    std::vector<bool> covered(lines.size(), false);
+
+    __boilerplate::lines::shingle(lines, k, [&](std::uint64_t hash, auto first, auto last) {
+        if (!boilerplate.contains(hash)) {
+            return;
+        }
+
+        for (auto it = first; it != last; ++it) {
+            covered[*it] = true;
+        }
+    });
+
+    std::string stripped;
+    stripped.reserve(text.size());
+
+    for (std::size_t idx = 0; idx < lines.size(); ++idx) {
+        if (covered[idx]) {
+            removed += 1;
+            continue;
+        }
+
+        stripped.append(lines[idx].text);
+        stripped.push_back('\n');
+    }
+
+    return stripped;
+}
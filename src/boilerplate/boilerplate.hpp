@@ -0,0 +1,68 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_BOILERPLATE_BOILERPLATE_HPP_
+#define SRC_BOILERPLATE_BOILERPLATE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+namespace boilerplate::defaults {
+
+/* Single lines, such as `}` or `return x`, are common in any code */
+constexpr std::size_t k = 3;
+
+}  // namespace boilerplate::defaults
+
+namespace boilerplate {
+
+/**
+ * Hashes the runs of consecutive non-blank lines of the text.
+ * 
+ * @param text the text to be shingled
+ * @param k the number of lines per shingle
+ * @return the hashes of the shingles
+ * 
+ * @note leading and trailing whitespace of the lines is ignored
+ * @note a text of fewer than `k` lines is a shingle of its own
+*/
+std::unordered_set<std::uint64_t> shingles(const std::string& text, std::size_t k = defaults::k);
+
+/**
+ * Removes the lines covered by the boilerplate shingles.
+ * 
+ * @param text the text to be stripped
+ * @param boilerplate the hashes of the boilerplate shingles
+ * @param k the number of lines per shingle
+ * @param removed the number of the removed lines, increased
+ * @return the stripped text
+*/
+std::string strip(
+    const std::string& text,
+    const std::unordered_set<std::uint64_t>& boilerplate,
+    std::size_t& removed,
+    std::size_t k = defaults::k);
+
+}  // namespace boilerplate
+
+#endif  // SRC_BOILERPLATE_BOILERPLATE_HPP_
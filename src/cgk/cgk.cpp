@@ -0,0 +1,144 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/cgk/cgk.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "src/kernels/kernels.hpp"
+
+namespace __cgk::random {
+
+constexpr std::uint64_t seed = 0x243F6A8885A308D3ULL;
+
+/* SplitMix64, a fixed function shared by all texts */
+constexpr std::uint64_t mix(std::uint64_t state) {
+    state += 0x9E3779B97F4A7C15ULL;
+    state = (state ^ (state >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    state = (state ^ (state >> 27)) * 0x94D049BB133111EBULL;
+    return state ^ (state >> 31);
+}
+
+/* Whether the walk of the repetition leaves the symbol at the step */
+constexpr bool advance(std::uint64_t repetition, std::size_t step, unsigned char symbol) {
+    auto key = mix(seed + repetition) ^ (static_cast<std::uint64_t>(step) << 8) ^ symbol;
+    return mix(key) & 1;
+}
+
+}  // namespace __cgk::random
+
+cgk::Embedding cgk::embed(const std::string& text, std::size_t repetitions) {
+    if (repetitions == 0) {
+        constexpr auto detail = "The number of repetitions must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    Embedding embedding{{}, text.size()};
+    embedding.walks.reserve(repetitions);
+
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition) {
+        std::string walk;
+        walk.reserve(2 * text.size());
+
+        std::size_t position = 0;
+
+        /* The walk consumes the whole text, `2n` steps are expected, the padding is left out */
+        for (std::size_t step = 0; position < text.size(); ++step) {
+            auto symbol = static_cast<unsigned char>(text[position]);
+            walk.push_back(text[position]);
+
+            if (__cgk::random::advance(repetition, step, symbol)) {
+                position += 1;
+            }
+        }
+
+        embedding.walks.push_back(std::move(walk));
+    }
+
+    return embedding;
+}
+
+std::size_t cgk::distance(const Embedding& lhs, const Embedding& rhs) {
+    if (lhs.walks.size() != rhs.walks.size()) {
+        constexpr auto detail = "The embeddings have different repetitions";
+        throw std::runtime_error(detail);
+    }
+
+    auto estimate = std::numeric_limits<std::size_t>::max();
+
+    for (std::size_t idx = 0; idx < lhs.walks.size(); ++idx) {
+        const auto& lhs_walk = lhs.walks[idx];
+        const auto& rhs_walk = rhs.walks[idx];
+
+        /* A real symbol never equals the padding */
+        auto padded = std::max(lhs_walk.size(), rhs_walk.size()) - std::min(lhs_walk.size(), rhs_walk.size());
+        auto hamming = kernels::mismatches(lhs_walk, rhs_walk) + padded;
+
+        estimate = std::min(estimate, hamming);
+    }
+
+    return estimate;
+}
+
+double cgk::similarity(const Embedding& lhs, const Embedding& rhs) {
+    auto maxlen = std::max(lhs.length, rhs.length);
+
+    if (maxlen == 0) {
+        return 1.0;
+    }
+
+    /* The distance is at least the difference of the lengths */
+    auto lower = maxlen - std::min(lhs.length, rhs.length);
+    auto estimate = std::clamp(cgk::distance(lhs, rhs), lower, maxlen);
+
+    return 1.0 - static_cast<double>(estimate) / maxlen;
+}
+
+cgk::Store::Store(std::size_t repetitions) : repetitions_(repetitions) {
+    if (repetitions == 0) {
+        constexpr auto detail = "The number of repetitions must be positive";
+        throw std::runtime_error(detail);
+    }
+}
+
+const cgk::Embedding& cgk::Store::load(const contents::Content& content) {
+    {
+        std::shared_lock lock(this->smutex_);
+
+        auto iterator = this->embeddings_.find(content.digest);
+        if (iterator != this->embeddings_.end()) {
+            return *iterator->second;
+        }
+    }
+
+    /* Embedding happens outside of the lock */
+    auto embedding = std::make_unique<Embedding>(cgk::embed(content.text, this->repetitions_));
+
+    std::unique_lock lock(this->smutex_);
+
+    auto [iterator, inserted] = this->embeddings_.try_emplace(content.digest, std::move(embedding));
+    return *iterator->second;
+}
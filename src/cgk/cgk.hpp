@@ -0,0 +1,122 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_CGK_CGK_HPP_
+#define SRC_CGK_CGK_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/contents/contents.hpp"
+
+namespace cgk {
+
+/**
+ * The `CGK` embedding of a text into the Hamming space.
+ * 
+ * @param walks the random walks over the text, one per repetition
+ * @param length the length of the text
+ * 
+ * @note the walks past the end of the text are implicitly padded
+*/
+struct Embedding {
+    std::vector<std::string> walks;
+    std::size_t length;
+};
+
+/**
+ * Embeds the text by random walks.
+ * 
+ * @param text the text
+ * @param repetitions the number of independent walks
+ * @return the embedding
+ * 
+ * @note the walks are seeded equally for every text, so embeddings are comparable
+ * @note every walk runs until the end of the text, `2n` steps are expected
+ * @note runs in expected linear time
+*/
+Embedding embed(const std::string& text, std::size_t repetitions);
+
+/**
+ * Estimates the `Levenshtein` distance from the embeddings.
+ * 
+ * @param lhs the embedding of the text
+ * @param rhs the embedding of the text
+ * @return the minimum Hamming distance of the walks
+ * 
+ * @throw std::runtime_error if the embeddings have different repetitions
+ * 
+ * @note the distance `K` of the texts is at most twice the estimate, always, since every walk
+ *       consumes its whole text
+ * @note with `R` repetitions, the estimate is `O(K^2)` with probability at least `1 - 3^-R`
+*/
+std::size_t distance(const Embedding& lhs, const Embedding& rhs);
+
+/**
+ * Estimates the `Levenshtein` similarity from the embeddings.
+ * 
+ * @param lhs the embedding of the text
+ * @param rhs the embedding of the text
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note runs in linear time
+*/
+double similarity(const Embedding& lhs, const Embedding& rhs);
+
+/**
+ * Storage that embeds every text at most once.
+ * 
+ * @note thread-safe
+ * @note the references returned remain valid for the lifetime of the store
+*/
+class Store {
+ public:
+    /**
+     * Creates an empty store.
+     * 
+     * @param repetitions the number of walks per text
+    */
+    explicit Store(std::size_t repetitions);
+
+    /**
+     * Embeds the file, only on the first request.
+     * 
+     * @param content the loaded file
+     * @return the embedding of the file
+    */
+    const Embedding& load(const contents::Content& content);
+
+ private:
+    std::size_t repetitions_;
+
+    mutable std::shared_mutex smutex_{};
+
+    std::unordered_map<std::string, std::unique_ptr<Embedding>> embeddings_;
+};
+
+}  // namespace cgk
+
+#endif  // SRC_CGK_CGK_HPP_
@@ -0,0 +1,457 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/chunks/chunks.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <mutex>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "lib/pathlib/pathlib.hpp"
+#include "lib/tempfile/tempfile.hpp"
+
+#include "src/ast/python/python.hpp"
+#include "src/estimators/alpha/alpha.hpp"
+#include "src/tokens/tokens.hpp"
+
+namespace __chunks::braces {
+
+/* Blocks of these are split into their nested blocks */
+constexpr std::string_view containers[] = {
+    "class",
+    "extern",
+    "impl",
+    "interface",
+    "module",
+    "namespace",
+    "object",
+    "struct",
+    "trait",
+};
+
+struct Block {
+    std::size_t first;
+    std::size_t last;
+    bool container;
+    std::vector<std::size_t> children;
+};
+
+bool is_container(std::string_view header) {
+    std::size_t idx = 0;
+
+    while (idx < header.size()) {
+        if (!std::isalpha(static_cast<unsigned char>(header[idx]))) {
+            idx += 1;
+            continue;
+        }
+
+        auto start = idx;
+        while (idx < header.size() && std::isalnum(static_cast<unsigned char>(header[idx]))) {
+            idx += 1;
+        }
+
+        auto word = header.substr(start, idx - start);
+        if (std::find(std::begin(containers), std::end(containers), word) != std::end(containers)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void resolve(
+    const std::vector<Block>& blocks,
+    std::size_t idx,
+    std::vector<ast::python::Span>& spans
+) {
+    const auto& block = blocks[idx];
+
+    if (!block.container || block.children.empty()) {
+        spans.push_back({block.first, block.last});
+        return;
+    }
+
+    for (auto child : block.children) {
+        resolve(blocks, child, spans);
+    }
+}
+
+/* Comments and literals are skipped, so their braces are not counted */
+std::vector<ast::python::Span> split(std::string_view text) {
+    std::vector<Block> blocks;
+    std::vector<std::size_t> roots;
+    std::vector<std::size_t> stack;
+
+    std::size_t line = 1;
+
+    /* The header of the next block starts after the last `;`, `{` or `}` */
+    std::size_t boundary = 0;
+    std::size_t pending = 0;
+
+    std::size_t idx = 0;
+
+    while (idx < text.size()) {
+        auto symbol = text[idx];
+        auto next = idx + 1 < text.size() ? text[idx + 1] : '\0';
+
+        if (symbol == '\n') {
+            line += 1;
+            idx += 1;
+            continue;
+        }
+
+        if (std::isspace(static_cast<unsigned char>(symbol))) {
+            idx += 1;
+            continue;
+        }
+
+        if (symbol == '/' && next == '/') {
+            while (idx < text.size() && text[idx] != '\n') {
+                idx += 1;
+            }
+            continue;
+        }
+
+        if (symbol == '/' && next == '*') {
+            auto end = text.find("*/", idx + 2);
+            end = (end == std::string_view::npos) ? text.size() : end + 2;
+
+            line += std::count(text.begin() + idx, text.begin() + end, '\n');
+            idx = end;
+            continue;
+        }
+
+        if (pending == 0) {
+            pending = line;
+        }
+
+        if (symbol == '"' || symbol == '\'') {
+            idx += 1;
+
+            while (idx < text.size() && text[idx] != symbol && text[idx] != '\n') {
+                idx += (text[idx] == '\\' && idx + 1 < text.size() && text[idx + 1] != '\n') ? 2 : 1;
+            }
+
+            if (idx < text.size() && text[idx] == symbol) {
+                idx += 1;
+            }
+            continue;
+        }
+
+        if (symbol == ';') {
+            boundary = idx + 1;
+            pending = 0;
+        } else if (symbol == '{') {
+            auto header = text.substr(boundary, idx - boundary);
+
+            stack.push_back(blocks.size());
+            blocks.push_back({pending, 0, is_container(header), {}});
+
+            boundary = idx + 1;
+            pending = 0;
+        } else if (symbol == '}') {
+            /* Unbalanced braces are ignored */
+            if (!stack.empty()) {
+                auto block = stack.back();
+                stack.pop_back();
+
+                blocks[block].last = line;
+
+                auto& parent = stack.empty() ? roots : blocks[stack.back()].children;
+                parent.push_back(block);
+            }
+
+            boundary = idx + 1;
+            pending = 0;
+        }
+
+        idx += 1;
+    }
+
+    std::vector<ast::python::Span> spans;
+
+    for (auto root : roots) {
+        resolve(blocks, root, spans);
+    }
+
+    return spans;
+}
+
+}  // namespace __chunks::braces
+
+namespace __chunks::indentation {
+
+std::size_t indent(std::string_view line) {
+    auto pivot = line.find_first_not_of(" \t");
+    return (pivot == std::string_view::npos) ? line.size() : pivot;
+}
+
+bool is_blank(std::string_view line) {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+/* Headers followed by deeper lines are units, class bodies are split further */
+void split(
+    const std::vector<std::string_view>& lines,
+    std::size_t begin,
+    std::size_t end,
+    std::vector<ast::python::Span>& spans
+) {
+    auto first = begin;
+    while (first < end && is_blank(lines[first])) {
+        first += 1;
+    }
+
+    if (first == end) {
+        return;
+    }
+
+    auto base = indent(lines[first]);
+    auto idx = first;
+
+    while (idx < end) {
+        if (is_blank(lines[idx]) || indent(lines[idx]) != base) {
+            idx += 1;
+            continue;
+        }
+
+        auto last = idx;
+        for (auto next = idx + 1; next < end; ++next) {
+            if (is_blank(lines[next])) {
+                continue;
+            }
+
+            if (indent(lines[next]) <= base) {
+                break;
+            }
+
+            last = next;
+        }
+
+        if (last == idx) {
+            idx += 1;
+            continue;
+        }
+
+        auto header = lines[idx].substr(base);
+
+        if (header.starts_with("class ")) {
+            split(lines, idx + 1, last + 1, spans);
+        } else {
+            spans.push_back({idx + 1, last + 1});
+        }
+
+        idx = last + 1;
+    }
+}
+
+}  // namespace __chunks::indentation
+
+namespace __chunks::units {
+
+std::vector<ast::python::Span> python(const std::string& text) {
+    auto path = tempfile::mkstemp();
+
+    try {
+        pathlib::write_text(path, text);
+        auto spans = ast::python::units(path);
+
+        std::filesystem::remove(path);
+        return spans;
+    }
+    catch (const std::exception&) {
+        std::filesystem::remove(path);
+        throw;
+    }
+}
+
+std::size_t weight(std::string_view text) {
+    auto count = std::count_if(text.begin(), text.end(), [](char symbol) {
+        return !std::isspace(static_cast<unsigned char>(symbol));
+    });
+
+    return static_cast<std::size_t>(count);
+}
+
+chunks::Unit make(std::string text) {
+    chunks::Unit unit;
+
+    unit.tokens = tokens::tokenize(text);
+    unit.text = std::move(text);
+
+    return unit;
+}
+
+/* Compares the pairs in the order of their upper bounds until none can beat the best */
+template <typename Bound, typename Estimate>
+double best(
+    const std::vector<chunks::Unit>& lhs,
+    const std::vector<chunks::Unit>& rhs,
+    Bound bound,
+    Estimate estimate
+) {
+    std::vector<std::tuple<double, std::size_t, std::size_t>> order;
+    order.reserve(lhs.size() * rhs.size());
+
+    for (std::size_t lidx = 0; lidx < lhs.size(); ++lidx) {
+        for (std::size_t ridx = 0; ridx < rhs.size(); ++ridx) {
+            order.emplace_back(bound(lhs[lidx], rhs[ridx]), lidx, ridx);
+        }
+    }
+
+    std::sort(order.begin(), order.end(), [](const auto& lhs, const auto& rhs) {
+        return std::get<0>(lhs) > std::get<0>(rhs);
+    });
+
+    double score = 0.0;
+
+    for (const auto& [limit, lidx, ridx] : order) {
+        if (limit <= score) {
+            break;
+        }
+
+        score = std::max(score, estimate(lhs[lidx], rhs[ridx]));
+    }
+
+    return score;
+}
+
+/* Quotient of the smaller and the larger size, one if both are empty */
+double ratio(std::size_t lhs, std::size_t rhs) {
+    if (lhs == 0 && rhs == 0) {
+        return 1.0;
+    }
+
+    return static_cast<double>(std::min(lhs, rhs)) / static_cast<double>(std::max(lhs, rhs));
+}
+
+}  // namespace __chunks::units
+
+std::vector<chunks::Unit> chunks::split(
+    const std::filesystem::path& path,
+    const std::string& text,
+    std::size_t minimum
+) {
+    std::vector<std::string_view> lines;
+
+    std::string_view view(text);
+    for (std::size_t start = 0; start <= view.size();) {
+        auto end = view.find('\n', start);
+        end = (end == std::string_view::npos) ? view.size() : end;
+
+        lines.push_back(view.substr(start, end - start));
+        start = end + 1;
+    }
+
+    std::vector<ast::python::Span> spans;
+    bool parsed = false;
+
+    if (path.extension() == ".py") {
+        try {
+            spans = __chunks::units::python(text);
+            parsed = true;
+        }
+        catch (const std::exception&) {
+            /* Not a valid `Python` code, the heuristics are used */
+        }
+    }
+
+    if (!parsed && view.find('{') != std::string_view::npos) {
+        spans = __chunks::braces::split(view);
+    } else if (!parsed) {
+        __chunks::indentation::split(lines, 0, lines.size(), spans);
+    }
+
+    std::vector<chunks::Unit> units;
+
+    for (const auto& span : spans) {
+        if (span.first == 0 || span.first > span.last || span.last > lines.size()) {
+            continue;
+        }
+
+        auto begin = lines[span.first - 1].data() - view.data();
+        auto end = lines[span.last - 1].data() + lines[span.last - 1].size() - view.data();
+
+        auto code = view.substr(begin, end - begin);
+
+        if (__chunks::units::weight(code) >= minimum) {
+            units.push_back(__chunks::units::make(std::string(code)));
+        }
+    }
+
+    if (units.empty()) {
+        units.push_back(__chunks::units::make(text));
+    }
+
+    return units;
+}
+
+double chunks::levenshtein(const std::vector<Unit>& lhs, const std::vector<Unit>& rhs) {
+    auto bound = [](const Unit& lhs, const Unit& rhs) {
+        return __chunks::units::ratio(lhs.text.size(), rhs.text.size());
+    };
+
+    auto estimate = [](const Unit& lhs, const Unit& rhs) {
+        return estimators::alpha::levenshtein(lhs.text, rhs.text);
+    };
+
+    return __chunks::units::best(lhs, rhs, bound, estimate);
+}
+
+double chunks::gst(const std::vector<Unit>& lhs, const std::vector<Unit>& rhs, std::size_t minimum) {
+    /* Tiles cover at most the smaller stream twice */
+    auto bound = [](const Unit& lhs, const Unit& rhs) {
+        auto ratio = __chunks::units::ratio(lhs.tokens.size(), rhs.tokens.size());
+        return 2.0 * ratio / (1.0 + ratio);
+    };
+
+    auto estimate = [minimum](const Unit& lhs, const Unit& rhs) {
+        return estimators::alpha::gst(lhs.tokens, rhs.tokens, minimum);
+    };
+
+    return __chunks::units::best(lhs, rhs, bound, estimate);
+}
+
+const std::vector<chunks::Unit>& chunks::Store::load(const contents::Content& content) {
+    /* The extension selects the splitter, so equal texts may split differently */
+    auto key = content.digest + ":" + content.path.string();
+
+    {
+        std::shared_lock lock(this->smutex_);
+
+        auto iterator = this->units_.find(key);
+        if (iterator != this->units_.end()) {
+            return *iterator->second;
+        }
+    }
+
+    /* Splitting happens outside of the lock */
+    auto units = std::make_unique<std::vector<Unit>>(chunks::split(content.path, content.text));
+
+    std::unique_lock lock(this->smutex_);
+
+    auto [iterator, inserted] = this->units_.try_emplace(key, std::move(units));
+    return *iterator->second;
+}
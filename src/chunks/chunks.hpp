@@ -0,0 +1,122 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_CHUNKS_CHUNKS_HPP_
+#define SRC_CHUNKS_CHUNKS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/contents/contents.hpp"
+
+namespace chunks::defaults {
+
+/* Shorter units, e.g. getters, are written alike by everyone */
+constexpr std::size_t minimum = 128;
+
+}  // namespace chunks::defaults
+
+namespace chunks {
+
+/**
+ * Function, method or class of the file.
+ * 
+ * @param text the code of the unit
+ * @param tokens the token stream of the code
+*/
+struct Unit {
+    std::string text;
+    std::vector<std::uint32_t> tokens;
+};
+
+/**
+ * Splits the file into the units.
+ * 
+ * @param path the path to the file, its extension selects the splitter
+ * @param text the contents of the file
+ * @param minimum the minimum number of non-whitespace characters in a unit
+ * @return the units in order
+ * 
+ * @note `Python` files are split by their abstract syntax tree
+ * @note other files are split by braces or, if there are none, by indentation
+ * @note a file without units is a unit of its own
+*/
+std::vector<Unit> split(
+    const std::filesystem::path& path,
+    const std::string& text,
+    std::size_t minimum = defaults::minimum);
+
+/**
+ * Returns the `Levenshtein` similarity of the most similar pair of units.
+ * 
+ * @param lhs the units of the file
+ * @param rhs the units of the file
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note the pairs are compared in the order of their length ratio, which bounds the score
+*/
+double levenshtein(const std::vector<Unit>& lhs, const std::vector<Unit>& rhs);
+
+/**
+ * Returns the `Greedy String Tiling` similarity of the most similar pair of units.
+ * 
+ * @param lhs the units of the file
+ * @param rhs the units of the file
+ * @param minimum the minimum length of a tile, in tokens
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note the pairs are compared in the order of their length ratio, which bounds the score
+*/
+double gst(const std::vector<Unit>& lhs, const std::vector<Unit>& rhs, std::size_t minimum);
+
+/**
+ * Storage that splits every file at most once.
+ * 
+ * @note thread-safe
+ * @note the references returned remain valid for the lifetime of the store
+*/
+class Store {
+ public:
+    /**
+     * Splits the file, only on the first request.
+     * 
+     * @param content the loaded file
+     * @return the units of the file
+    */
+    const std::vector<Unit>& load(const contents::Content& content);
+
+ private:
+    mutable std::shared_mutex smutex_{};
+
+    std::unordered_map<std::string, std::unique_ptr<std::vector<Unit>>> units_;
+};
+
+}  // namespace chunks
+
+#endif  // SRC_CHUNKS_CHUNKS_HPP_
@@ -0,0 +1,103 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/contents/contents.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "lib/hashlib/hashlib.hpp"
+#include "lib/pathlib/pathlib.hpp"
+
+#include "src/fingerprints/fingerprints.hpp"
+#include "src/tokens/tokens.hpp"
+
+namespace contents {
+
+Content prepare(const std::filesystem::path& path, std::string text) {
+    Content content;
+
+    content.path = path;
+    content.text = std::move(text);
+    content.digest = hashlib::sha256(content.text);
+    content.fingerprints = fingerprints::winnow(
+        content.text,
+        fingerprints::defaults::k,
+        fingerprints::defaults::window);
+
+    content.histogram.fill(0);
+    for (auto symbol : content.text) {
+        content.histogram[static_cast<unsigned char>(symbol)] += 1;
+    }
+
+    content.tokens = tokens::tokenize(content.text);
+
+    return content;
+}
+
+std::string merkle(const std::vector<std::string>& labels, const std::vector<const Content*>& files) {
+    if (labels.size() != files.size()) {
+        constexpr auto detail = "Every file must have a label";
+        throw std::runtime_error(detail);
+    }
+
+    std::vector<std::string> leaves;
+    leaves.reserve(files.size());
+
+    /* Labels cannot contain the null character, so the leaves are unambiguous */
+    for (std::size_t idx = 0; idx < files.size(); ++idx) {
+        leaves.push_back(labels[idx] + '\0' + files[idx]->digest);
+    }
+
+    std::sort(leaves.begin(), leaves.end());
+
+    std::string tree;
+    for (const auto& leaf : leaves) {
+        tree += hashlib::sha256(leaf);
+    }
+
+    return hashlib::sha256(tree);
+}
+
+const Content& Store::load(const std::filesystem::path& path) {
+    auto key = path.string();
+
+    {
+        std::shared_lock lock(this->smutex_);
+
+        auto iterator = this->contents_.find(key);
+        if (iterator != this->contents_.end()) {
+            return *iterator->second;
+        }
+    }
+
+    /* Reading and hashing happen outside of the lock */
+    auto content = std::make_unique<Content>(prepare(path, pathlib::read_text(path)));
+
+    std::unique_lock lock(this->smutex_);
+
+    auto [iterator, inserted] = this->contents_.try_emplace(key, std::move(content));
+    return *iterator->second;
+}
+
+}  // namespace contents
@@ -0,0 +1,101 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_CONTENTS_CONTENTS_HPP_
+#define SRC_CONTENTS_CONTENTS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace contents {
+
+/**
+ * Representation of the loaded file.
+ * 
+ * @param path the path to the file
+ * @param text the contents of the file
+ * @param digest the `SHA-256` digest of the contents
+ * @param fingerprints the winnowed fingerprints of the contents
+ * @param histogram the number of occurrences of every byte
+ * @param tokens the token stream of the contents
+*/
+struct Content {
+    std::filesystem::path path;
+    std::string text;
+    std::string digest;
+    std::vector<std::uint64_t> fingerprints;
+    std::array<std::size_t, 256> histogram;
+    std::vector<std::uint32_t> tokens;
+};
+
+/**
+ * Prepares the file that has already been read.
+ * 
+ * @param path the path to the file
+ * @param text the contents of the file
+ * @return the prepared file
+*/
+Content prepare(const std::filesystem::path& path, std::string text);
+
+/**
+ * Hashes the tree of the files.
+ * 
+ * @param labels the paths to the files, relative to the root of the tree
+ * @param files the loaded files
+ * @return the `SHA-256` digest of the tree
+ * 
+ * @note equal trees, i.e. equal labels with equal contents, share the digest
+ * @note the order of the files does not matter
+*/
+std::string merkle(const std::vector<std::string>& labels, const std::vector<const Content*>& files);
+
+/**
+ * Storage that reads every file at most once.
+ * 
+ * @note thread-safe
+ * @note the references returned remain valid for the lifetime of the store
+*/
+class Store {
+ public:
+    /**
+     * Loads the file, reading it only on the first request.
+     * 
+     * @param path the path to the file
+     * @return the loaded file
+    */
+    const Content& load(const std::filesystem::path& path);
+
+ private:
+    mutable std::shared_mutex smutex_{};
+
+    std::unordered_map<std::string, std::unique_ptr<Content>> contents_;
+};
+
+}  // namespace contents
+
+#endif  // SRC_CONTENTS_CONTENTS_HPP_
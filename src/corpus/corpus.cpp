@@ -0,0 +1,360 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/corpus/corpus.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "lib/hashlib/hashlib.hpp"
+
+#include "src/fingerprints/fingerprints.hpp"
+
+namespace __corpus::layout {
+
+std::filesystem::path catalog(const std::filesystem::path& directory) {
+    std::filesystem::create_directories(directory / "segments");
+    return directory / "catalog.log";
+}
+
+std::filesystem::path texts(const std::filesystem::path& directory) {
+    return directory / "texts.log";
+}
+
+}  // namespace __corpus::layout
+
+namespace __corpus::segment {
+
+/* Segments are written in the native byte order */
+constexpr std::uint32_t magic = 0x32534347;  // "GCS2"
+
+/* The files of a segment have the consecutive identifiers starting at `first` */
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t k;
+    std::uint32_t window;
+    std::uint32_t reserved;
+    std::uint32_t first;
+    std::uint32_t files;
+    std::uint64_t count;
+};
+
+struct Posting {
+    std::uint64_t hash;
+    std::uint32_t file;
+    std::uint32_t reserved;
+};
+
+/* Fingerprints shared by too many files carry no information */
+constexpr std::size_t stopword = 4096;
+
+std::pair<const Posting*, const Posting*> postings(const memmap::File& segment) {
+    const auto* header = reinterpret_cast<const Header*>(segment.data());
+    const auto* begin = reinterpret_cast<const Posting*>(segment.data() + sizeof(Header));
+
+    return {begin, begin + header->count};
+}
+
+void validate(const memmap::File& segment, const std::filesystem::path& path) {
+    auto detail = std::format("The corpus segment {} is corrupted", path.string());
+
+    if (segment.size() < sizeof(Header)) {
+        throw std::runtime_error(detail);
+    }
+
+    const auto* header = reinterpret_cast<const Header*>(segment.data());
+
+    if (header->magic != magic) {
+        throw std::runtime_error(detail);
+    }
+
+    if (header->k != fingerprints::defaults::k || header->window != fingerprints::defaults::window) {
+        auto detail = std::format(
+            "The corpus segment {} uses incompatible fingerprints",
+            path.string());
+        throw std::runtime_error(detail);
+    }
+
+    if (segment.size() != sizeof(Header) + header->count * sizeof(Posting)) {
+        throw std::runtime_error(detail);
+    }
+
+    if (header->files > std::numeric_limits<std::uint32_t>::max() - header->first) {
+        throw std::runtime_error(detail);
+    }
+}
+
+/* Renamed into place, the segment commits the catalog entries of its files */
+std::filesystem::path write(
+    const std::filesystem::path& directory,
+    std::uint32_t first,
+    std::uint32_t files,
+    const std::vector<std::pair<std::uint64_t, std::uint32_t>>& pending
+) {
+    auto path = directory / "segments" / std::format("{:010}.postings", first);
+
+    auto temporary = path;
+    temporary += ".tmp";
+
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+
+    if (!stream.is_open()) {
+        auto detail = std::format("Failed to open the file {}", temporary.string());
+        throw std::runtime_error(detail);
+    }
+
+    Header header{
+        magic,
+        static_cast<std::uint32_t>(fingerprints::defaults::k),
+        static_cast<std::uint32_t>(fingerprints::defaults::window),
+        0,
+        first,
+        files,
+        pending.size()};
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& [hash, file] : pending) {
+        Posting posting{hash, first + file, 0};
+        stream.write(reinterpret_cast<const char*>(&posting), sizeof(posting));
+    }
+
+    stream.close();
+
+    if (!stream) {
+        std::filesystem::remove(temporary);
+
+        auto detail = std::format("Failed to write the file {}", temporary.string());
+        throw std::runtime_error(detail);
+    }
+
+    /* Queries never observe a partially written segment */
+    std::filesystem::rename(temporary, path);
+
+    return path;
+}
+
+}  // namespace __corpus::segment
+
+namespace corpus {
+
+Index::Index(const std::filesystem::path& directory)
+    : directory_(directory),
+      catalog_(__corpus::layout::catalog(directory)),
+      texts_(__corpus::layout::texts(directory)) {
+    std::vector<std::filesystem::path> paths;
+
+    for (const auto& entity : std::filesystem::directory_iterator(directory / "segments")) {
+        if (entity.path().extension() == ".postings") {
+            paths.push_back(entity.path());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto& path : paths) {
+        auto segment = std::make_unique<memmap::File>(path);
+        __corpus::segment::validate(*segment, path);
+        this->segments_.push_back(std::move(segment));
+    }
+
+    /* Re-running a workflow must not index its files twice, the uncommitted entries are ignored */
+    for (const auto& segment : this->segments_) {
+        const auto* header = reinterpret_cast<const __corpus::segment::Header*>(segment->data());
+
+        for (std::uint32_t idx = 0; idx < header->files; ++idx) {
+            this->entries_.insert(this->catalog_.read(std::to_string(header->first + idx)).value);
+        }
+
+        this->files_ += header->files;
+    }
+}
+
+bool Index::add(const std::string& submission, const std::string& path, const std::string& text) {
+    auto digest = hashlib::sha256(text);
+    auto entry = std::format("{}\n{}\n{}", digest, submission, path);
+
+    if (!this->entries_.insert(entry).second) {
+        return false;
+    }
+
+    auto file = static_cast<std::uint32_t>(this->staged_.size());
+    this->staged_.push_back(entry);
+
+    /* The texts are addressed by their digests, so an uncommitted one is harmless */
+    if (!this->texts_.exists(digest)) {
+        this->texts_.write(digest, text);
+    }
+
+    auto fingerprints = fingerprints::winnow(
+        text,
+        fingerprints::defaults::k,
+        fingerprints::defaults::window);
+
+    for (auto hash : fingerprints) {
+        this->pending_.emplace_back(hash, file);
+    }
+
+    return true;
+}
+
+void Index::commit(void) {
+    if (this->staged_.empty()) {
+        return;
+    }
+
+    std::sort(this->pending_.begin(), this->pending_.end());
+
+    std::filesystem::path path;
+
+    /* The identifiers are taken under the lock, the crashed commits leave theirs unused */
+    this->catalog_.transact([&](std::size_t size, const kvcache::Writer& write) {
+        if (this->staged_.size() > std::numeric_limits<std::uint32_t>::max() - size) {
+            constexpr auto detail = "The corpus is out of file identifiers";
+            throw std::runtime_error(detail);
+        }
+
+        auto first = static_cast<std::uint32_t>(size);
+        auto files = static_cast<std::uint32_t>(this->staged_.size());
+
+        for (std::uint32_t idx = 0; idx < files; ++idx) {
+            write(std::to_string(first + idx), this->staged_[idx]);
+        }
+
+        path = __corpus::segment::write(this->directory_, first, files, this->pending_);
+    });
+
+    this->segments_.push_back(std::make_unique<memmap::File>(path));
+    this->files_ += this->staged_.size();
+
+    this->pending_.clear();
+    this->staged_.clear();
+}
+
+std::vector<Candidate> Index::query(
+    const std::string& text,
+    std::size_t limit,
+    double threshold,
+    const std::string& label
+) const {
+    auto fingerprints = fingerprints::winnow(
+        text,
+        fingerprints::defaults::k,
+        fingerprints::defaults::window);
+
+    if (fingerprints.empty()) {
+        return {};
+    }
+
+    std::unordered_map<std::uint32_t, std::size_t> shared;
+
+    for (auto hash : fingerprints) {
+        for (const auto& segment : this->segments_) {
+            auto [begin, end] = __corpus::segment::postings(*segment);
+
+            auto first = std::lower_bound(
+                begin,
+                end,
+                hash,
+                [](const auto& posting, std::uint64_t value) { return posting.hash < value; });
+
+            auto last = std::upper_bound(
+                first,
+                end,
+                hash,
+                [](std::uint64_t value, const auto& posting) { return value < posting.hash; });
+
+            if (static_cast<std::size_t>(last - first) > __corpus::segment::stopword) {
+                continue;
+            }
+
+            for (auto posting = first; posting != last; ++posting) {
+                shared[posting->file] += 1;
+            }
+        }
+    }
+
+    std::vector<Candidate> candidates;
+
+    auto prefix = label + "/";
+
+    for (const auto& [id, count] : shared) {
+        auto overlap = static_cast<double>(count) / fingerprints.size();
+
+        if (overlap < threshold) {
+            continue;
+        }
+
+        /* The labeled submissions are left out before the limit is applied */
+        if (!label.empty() && this->file(id).submission.starts_with(prefix)) {
+            continue;
+        }
+
+        candidates.push_back(Candidate{id, overlap});
+    }
+
+    auto comparator = [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.overlap > rhs.overlap || (lhs.overlap == rhs.overlap && lhs.id < rhs.id);
+    };
+    std::sort(candidates.begin(), candidates.end(), comparator);
+
+    if (candidates.size() > limit) {
+        candidates.resize(limit);
+    }
+
+    return candidates;
+}
+
+File Index::file(std::uint32_t id) const {
+    auto entry = this->catalog_.read(std::to_string(id)).value;
+
+    auto first = entry.find('\n');
+    auto second = entry.find('\n', first + 1);
+
+    if (first == std::string::npos || second == std::string::npos) {
+        auto detail = std::format("The corpus entry {} is corrupted", id);
+        throw std::runtime_error(detail);
+    }
+
+    File file;
+    file.digest = entry.substr(0, first);
+    file.submission = entry.substr(first + 1, second - first - 1);
+    file.path = entry.substr(second + 1);
+
+    return file;
+}
+
+std::string Index::text(std::uint32_t id) const {
+    auto digest = this->file(id).digest;
+    return this->texts_.read(digest).value;
+}
+
+std::size_t Index::size(void) const {
+    return this->files_;
+}
+
+}  // namespace corpus
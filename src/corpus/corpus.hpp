@@ -0,0 +1,158 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_CORPUS_CORPUS_HPP_
+#define SRC_CORPUS_CORPUS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "lib/memmap/memmap.hpp"
+
+#include "src/kvcache/kvcache.hpp"
+
+namespace corpus {
+
+/**
+ * Representation of the indexed file.
+ * 
+ * @param submission the name of the submission the file belongs to
+ * @param path the path to the file relative to the submission
+ * @param digest the `SHA-256` digest of the normalized contents
+*/
+struct File {
+    std::string submission;
+    std::string path;
+    std::string digest;
+};
+
+/**
+ * Representation of the indexed file retrieved by a query.
+ * 
+ * @param id the identifier of the file
+ * @param overlap the fraction of the query fingerprints found in the file
+*/
+struct Candidate {
+    std::uint32_t id;
+    double overlap;
+};
+
+/**
+ * Persistent fingerprint index of the previously checked submissions.
+ * 
+ * @note the postings are split into immutable memory-mapped segments
+ * @note every `commit` adds a new segment, so the index grows incrementally
+ * @note queries are thread-safe, modifications are not
+ * @note several processes may extend the index at once
+*/
+class Index {
+ public:
+    /**
+     * Opens the index, creating an empty one if necessary.
+     * 
+     * @param directory the path to the index directory
+    */
+    explicit Index(const std::filesystem::path& directory);
+
+    /**
+     * Adds the normalized file to the pending segment.
+     * 
+     * @param submission the name of the submission the file belongs to
+     * @param path the path to the file relative to the submission
+     * @param text the normalized contents of the file
+     * @return if the file was added
+     * 
+     * @note a file already indexed with the same submission, path and contents is skipped
+    */
+    bool add(const std::string& submission, const std::string& path, const std::string& text);
+
+    /**
+     * Writes the pending segment to the disk.
+     * 
+     * @note the identifiers and the catalog entries are written under the lock of the catalog
+     * @note the files count as indexed only once their segment is in place
+    */
+    void commit(void);
+
+    /**
+     * Retrieves the indexed files sharing fingerprints with the text.
+     * 
+     * @param text the normalized contents of the file
+     * @param limit the maximum number of candidates
+     * @param threshold the minimum overlap of a candidate
+     * @param label the label of the submissions left out, none if empty
+     * @return the candidates in the descending order of overlap
+     * 
+     * @note the submissions are labeled as `<label>/<name>`
+    */
+    std::vector<Candidate> query(
+        const std::string& text,
+        std::size_t limit,
+        double threshold,
+        const std::string& label = "") const;
+
+    /**
+     * Gets the description of the indexed file.
+     * 
+     * @param id the identifier of the file
+     * @return the description of the file
+    */
+    File file(std::uint32_t id) const;
+
+    /**
+     * Gets the normalized contents of the indexed file.
+     * 
+     * @param id the identifier of the file
+     * @return the contents of the file
+    */
+    std::string text(std::uint32_t id) const;
+
+    /**
+     * Counts the indexed files.
+     * 
+     * @return the number of files
+    */
+    std::size_t size(void) const;
+
+ private:
+    std::filesystem::path directory_;
+
+    kvcache::Store catalog_;
+    kvcache::Store texts_;
+
+    std::vector<std::unique_ptr<memmap::File>> segments_;
+
+    std::unordered_set<std::string> entries_;
+
+    std::size_t files_ = 0;
+
+    std::vector<std::string> staged_;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> pending_;
+};
+
+}  // namespace corpus
+
+#endif  // SRC_CORPUS_CORPUS_HPP_
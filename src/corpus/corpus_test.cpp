@@ -0,0 +1,126 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <string>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/corpus/corpus.hpp"
+
+namespace __corpus::test {
+
+const auto directory = std::filesystem::temp_directory_path() / "gelada-corpus-test";
+
+/* Long enough to yield fingerprints, distinct for every seed */
+std::string text(std::size_t seed) {
+    std::string text;
+
+    for (std::size_t line = 0; line < 200; ++line) {
+        text += std::format("value_{} = compute({}, {})\n", seed, line * 7 % 13, line + seed);
+    }
+
+    return text;
+}
+
+/* The committed files survive the reopening, the staged ones do not */
+bool reopened(void) {
+    {
+        corpus::Index index(directory);
+
+        if (!index.add("f23/alice", "main.py", text(1)) || !index.add("f23/bob", "main.py", text(2))) {
+            return false;
+        }
+
+        /* The same submission, path and contents are indexed once */
+        if (index.add("f23/alice", "main.py", text(1))) {
+            return false;
+        }
+
+        index.commit();
+
+        index.add("f23/carol", "main.py", text(3));
+    }
+
+    corpus::Index index(directory);
+
+    if (index.size() != 2 || index.add("f23/bob", "main.py", text(2))) {
+        return false;
+    }
+
+    auto file = index.file(0);
+
+    return file.submission == "f23/alice"
+        && file.path == "main.py"
+        && index.text(0) == text(1)
+        && index.file(1).submission == "f23/bob"
+        && index.text(1) == text(2);
+}
+
+/* A file finds itself first, unless its label is left out */
+bool queried(void) {
+    corpus::Index index(directory);
+
+    index.add("f24/dave", "main.py", text(1));
+    index.commit();
+
+    auto candidates = index.query(text(1), 16, 0.5);
+
+    if (index.size() != 3 || candidates.size() != 2 || candidates.front().overlap != 1.0) {
+        return false;
+    }
+
+    auto labeled = index.query(text(1), 16, 0.5, "f24");
+
+    return labeled.size() == 1 && labeled.front().id == 0;
+}
+
+}  // namespace __corpus::test
+
+int main() {
+    namespace test = __corpus::test;
+
+    try {
+        std::filesystem::remove_all(test::directory);
+        std::filesystem::create_directories(test::directory);
+
+        if (!test::reopened()) {
+            logging::error("The committed files differ after reopening the index");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::queried()) {
+            logging::error("The query missed the indexed files");
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove_all(test::directory);
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -24,7 +24,10 @@
 
 #include "src/documents/execflow/execflow.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <format>
 #include <functional>
@@ -35,15 +38,19 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <experimental/embed>
 
 #include <BS_thread_pool.hpp>
 
+#include "lib/hashlib/hashlib.hpp"
 #include "lib/itertools/itertools.hpp"
+#include "lib/pathlib/pathlib.hpp"
 
 #include "src/ast/anylang/anylang.hpp"
 #include "src/bitbucket/bitbucket.hpp"
+#include "src/boilerplate/boilerplate.hpp"
 #include "src/errors/filesystem/filesystem.hpp"
 #include "src/ext/rapidjson/build/build.hpp"
 #include "src/ext/rapidjson/schema/schema.hpp"
@@ -109,6 +116,15 @@ void validate(const rapidjson::Document& execflow) {
         }
     }
 
+    if (execflow.HasMember("boilerplate") && execflow["boilerplate"].HasMember("path")) {
+        std::string path = execflow["boilerplate"]["path"].GetString();
+
+        if (!std::filesystem::is_directory(path)) {
+            auto detail = std::format("The execflow boilerplate has non-directory path \"{}\"", path);
+            throw std::runtime_error(detail);
+        }
+    }
+
     if (submissions.size() <= 1) {
         constexpr auto detail = "There must be at least two submissions within the execflow";
         throw std::runtime_error(detail);
@@ -117,6 +133,64 @@ void validate(const rapidjson::Document& execflow) {
 
 }  // namespace __documents::execflow::specification
 
+namespace __documents::execflow::execroots {
+
+/* The submissions and the boilerplate */
+std::vector<std::filesystem::path> all(const rapidjson::Document& execflow) {
+    std::vector<std::filesystem::path> dirs;
+
+    for (const auto& submission : execflow["submissions"].GetArray()) {
+        dirs.emplace_back(submission["path"].GetString());
+    }
+
+    if (execflow.HasMember("boilerplate") && execflow["boilerplate"].HasMember("path")) {
+        dirs.emplace_back(execflow["boilerplate"]["path"].GetString());
+    }
+
+    return dirs;
+}
+
+}  // namespace __documents::execflow::execroots
+
+namespace __documents::execflow::filter {
+
+shutil::Filter from_workflow(const rapidjson::Document& workflow) {
+    shutil::Filter filter;
+
+    if (!workflow.HasMember("filter")) {
+        return filter;
+    }
+
+    const auto& options = workflow["filter"];
+
+    if (options.HasMember("include")) {
+        for (const auto& pattern : options["include"].GetArray()) {
+            filter.include.push_back(pattern.GetString());
+        }
+    }
+
+    if (options.HasMember("exclude")) {
+        for (const auto& pattern : options["exclude"].GetArray()) {
+            filter.exclude.push_back(pattern.GetString());
+        }
+    }
+
+    if (options.HasMember("min_size")) {
+        filter.min_size = options["min_size"].GetUint64();
+    }
+
+    if (options.HasMember("max_size")) {
+        filter.max_size = options["max_size"].GetUint64();
+    }
+
+    /* Binary files are not comparable as text */
+    filter.binary = options.HasMember("binary") && options["binary"].GetBool();
+
+    return filter;
+}
+
+}  // namespace __documents::execflow::filter
+
 namespace __documents::execflow::cache::timeout {
 
 static constexpr const std::size_t hours = 1ULL;
@@ -125,17 +199,18 @@ static constexpr const std::size_t hours = 1ULL;
 
 namespace __documents::execflow::cache {
 
-static std::mutex mutex;
-
 std::filesystem::path tryread(const std::string& key) {
-    std::lock_guard lock(__documents::execflow::cache::mutex);
+    auto& store = kvcache::open("repositories");
 
-    if (!kvcache::exists(key)) {
+    kvcache::Cache cached;
+
+    try {
+        cached = store.read(key);
+    }
+    catch (const std::exception&) {
         return "";
     }
 
-    auto cached = kvcache::read(key);
-
     auto t1 = std::chrono::system_clock::now();
     auto t2 = std::chrono::system_clock::from_time_t(cached.timestamp);
 
@@ -143,7 +218,7 @@ std::filesystem::path tryread(const std::string& key) {
     auto hours = duration.count();
 
     if (hours > __documents::execflow::cache::timeout::hours) {
-        kvcache::drop(key);
+        store.drop(key);
         return "";
     }
 
@@ -151,8 +226,7 @@ std::filesystem::path tryread(const std::string& key) {
 }
 
 void write(const std::string& key, const std::filesystem::path& path) {
-    std::lock_guard lock(__documents::execflow::cache::mutex);
-    kvcache::write(key, path.string());
+    kvcache::open("repositories").write(key, path.string());
 }
 
 }  // namespace __documents::execflow::cache
@@ -163,6 +237,28 @@ static std::mutex mutex;
 
 }  // namespace __documents::execflow::python
 
+namespace __documents::execflow::normalization {
+
+/* Results are reused across runs, sparing the `Python` calls */
+void normalize(const std::filesystem::path& path) {
+    auto& store = kvcache::open("normalization");
+
+    auto text = pathlib::read_text(path);
+    auto key = std::format("{}:{}", ast::anylang::version, hashlib::sha256(text));
+
+    if (store.exists(key)) {
+        pathlib::write_text(path, store.read(key).value);
+        return;
+    }
+
+    constexpr bool inplace = true;
+    ast::anylang::normalize(path, inplace);
+
+    store.write(key, pathlib::read_text(path));
+}
+
+}  // namespace __documents::execflow::normalization
+
 namespace __documents::execflow::parallel {
 
 auto fetch_latest(const rapidjson::Document& workflow, std::size_t threads) {
@@ -228,6 +324,7 @@ rapidjson::Document documents::execflow::parallel::from_workflow(
     std::size_t threads
 ) {
     auto latest = __documents::execflow::parallel::fetch_latest(workflow, threads);
+    auto filter = __documents::execflow::filter::from_workflow(workflow);
 
     rapidjson::Document execflow;
     execflow.SetObject();
@@ -252,11 +349,11 @@ rapidjson::Document documents::execflow::parallel::from_workflow(
             throw std::runtime_error(detail);
         }
 
-        auto execroot = shutil::seal(workroot);
+        auto execroot = shutil::seal(workroot, filter);
 
         if (!itertools::contains::regular_files(execroot)) {
             auto detail = std::format(
-                "The path {} points to an empty directory or consists only of symlinks",
+                "The path {} points to an empty directory or consists only of symlinks and filtered files",
                 execroot.string());
             throw std::runtime_error(detail);
         }
@@ -277,9 +374,49 @@ rapidjson::Document documents::execflow::parallel::from_workflow(
         submission.AddMember("name", name, allocator);
         submission.AddMember("path", path, allocator);
 
+        if (raw_submission.HasMember("suspect")) {
+            auto suspect = raw_submission["suspect"].GetBool();
+            submission.AddMember("suspect", suspect, allocator);
+        }
+
         execflow["submissions"].PushBack(submission, allocator);
     }
 
+    if (workflow.HasMember("boilerplate")) {
+        const auto& raw_boilerplate = workflow["boilerplate"];
+        auto& allocator = execflow.GetAllocator();
+
+        rapidjson::Value boilerplate;
+        boilerplate.SetObject();
+
+        if (raw_boilerplate.HasMember("path")) {
+            std::filesystem::path workroot = raw_boilerplate["path"].GetString();
+
+            if (!std::filesystem::exists(workroot)) {
+                throw errors::filesystem::FileNotFoundError(workroot);
+            }
+
+            auto path = rapidjson::build::string(shutil::seal(workroot, filter).string(), allocator);
+            boilerplate.AddMember("path", path, allocator);
+        }
+
+        if (raw_boilerplate.HasMember("frequency")) {
+            auto frequency = raw_boilerplate["frequency"].GetDouble();
+            boilerplate.AddMember("frequency", frequency, allocator);
+        }
+
+        execflow.AddMember("boilerplate", boilerplate, allocator);
+    }
+
+    if (workflow.HasMember("compatibility")) {
+        auto& allocator = execflow.GetAllocator();
+
+        rapidjson::Value compatibility;
+        compatibility.CopyFrom(workflow["compatibility"], allocator);
+
+        execflow.AddMember("compatibility", compatibility, allocator);
+    }
+
     /* Throws an exception on any specification mismatch */
     __documents::execflow::specification::validate(execflow);
 
@@ -298,14 +435,12 @@ void documents::execflow::parallel::normalize(
     BS::thread_pool pool(threads);
     std::vector<std::future<void>> tasks;
 
-    for (const auto& submission : execflow["submissions"].GetArray()) {
-        std::filesystem::path dir = submission["path"].GetString();
-
+    /* The boilerplate must look like the normalized submissions */
+    for (const auto& dir : __documents::execflow::execroots::all(execflow)) {
         for (const auto& entity : std::filesystem::recursive_directory_iterator(dir)) {
             if (std::filesystem::is_regular_file(entity)) {
                 tasks.push_back(pool.submit_task([entity]{
-                    constexpr bool inplace = true;
-                    ast::anylang::normalize(entity, inplace);
+                    __documents::execflow::normalization::normalize(entity);
                 }));
             }
         }
@@ -328,10 +463,109 @@ void documents::execflow::parallel::rmtree(
 
     BS::thread_pool pool(threads);
 
-    for (const auto& submission : execflow["submissions"].GetArray()) {
-        std::filesystem::path dir = submission["path"].GetString();
+    for (const auto& dir : __documents::execflow::execroots::all(execflow)) {
         pool.submit_task([dir]{ std::filesystem::remove_all(dir); });
     }
 
     pool.wait();
 }
+
+std::size_t documents::execflow::parallel::strip(
+    const rapidjson::Document& execflow,
+    std::size_t threads
+) {
+    if (threads == 0) {
+        constexpr auto detail = "The number of threads must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    if (!execflow.HasMember("boilerplate")) {
+        return 0;
+    }
+
+    const auto& options = execflow["boilerplate"];
+
+    BS::thread_pool pool(threads);
+
+    std::vector<std::vector<std::filesystem::path>> submissions;
+    for (const auto& submission : execflow["submissions"].GetArray()) {
+        submissions.push_back(itertools::collect::regular_files(submission["path"].GetString()));
+    }
+
+    std::unordered_set<std::uint64_t> common;
+
+    if (options.HasMember("path")) {
+        for (const auto& file : itertools::collect::regular_files(options["path"].GetString())) {
+            common.merge(boilerplate::shingles(pathlib::read_text(file)));
+        }
+    }
+
+    if (options.HasMember("frequency")) {
+        std::vector<std::unordered_set<std::uint64_t>> shingles(submissions.size());
+        std::vector<std::future<void>> tasks;
+
+        for (std::size_t idx = 0; idx < submissions.size(); ++idx) {
+            tasks.push_back(pool.submit_task([&, idx]{
+                for (const auto& file : submissions[idx]) {
+                    shingles[idx].merge(boilerplate::shingles(pathlib::read_text(file)));
+                }
+            }));
+        }
+
+        /* The tasks refer to the locals, so all of them finish before any rethrow */
+        pool.wait();
+
+        for (auto& task : tasks) {
+            task.get();
+        }
+
+        /* The number of the submissions containing the shingle */
+        std::unordered_map<std::uint64_t, std::size_t> frequencies;
+
+        for (const auto& submission_shingles : shingles) {
+            for (auto shingle : submission_shingles) {
+                frequencies[shingle] += 1;
+            }
+        }
+
+        auto limit = options["frequency"].GetDouble() * static_cast<double>(submissions.size());
+
+        for (const auto& [shingle, frequency] : frequencies) {
+            if (static_cast<double>(frequency) > limit) {
+                common.insert(shingle);
+            }
+        }
+    }
+
+    if (common.empty()) {
+        return 0;
+    }
+
+    std::atomic<std::size_t> removed = 0;
+    std::vector<std::future<void>> tasks;
+
+    for (const auto& files : submissions) {
+        for (const auto& file : files) {
+            tasks.push_back(pool.submit_task([&, file]{
+                std::size_t count = 0;
+
+                auto text = pathlib::read_text(file);
+                auto stripped = boilerplate::strip(text, common, count);
+
+                if (count != 0) {
+                    pathlib::write_text(file, stripped);
+                    removed += count;
+                }
+            }));
+        }
+    }
+
+    pool.wait();
+
+    /* Rethrow exceptions */
+    for (auto& task : tasks) {
+        task.get();
+    }
+
+    return removed;
+}
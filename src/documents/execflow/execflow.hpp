@@ -45,13 +45,25 @@ rapidjson::Document from_workflow(const rapidjson::Document& workflow, std::size
 void normalize(const rapidjson::Document& execflow, std::size_t threads);
 
 /**
- * Deletes the `execroot`s listed in the document.
+ * Deletes the `execroot`s listed in the document, including the boilerplate.
  * 
  * @param execflow the `execflow` type document
  * @param threads the number of threads to be used
 */
 void rmtree(const rapidjson::Document& execflow, std::size_t threads);
 
+/**
+ * Strips the boilerplate from the `execroot`s listed in the document.
+ * 
+ * @param execflow the `execflow` type document
+ * @param threads the number of threads to be used
+ * @return the number of the removed lines
+ * 
+ * @note the shingles of the template and of the frequent lines are the boilerplate
+ * @note does nothing if the document has no boilerplate
+*/
+std::size_t strip(const rapidjson::Document& execflow, std::size_t threads);
+
 }  // namespace documents::execflow::parallel
 
 #endif  // SRC_DOCUMENTS_EXECFLOW_EXECFLOW_HPP_
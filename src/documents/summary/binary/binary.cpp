@@ -0,0 +1,320 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/documents/summary/binary/binary.hpp"
+
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace __documents::summary::binary {
+
+/* Summaries are written in the native byte order */
+constexpr std::uint32_t magic = 0x31425347;  // "GSB1"
+
+/* The counts of the entities, then the file offsets of the columns */
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t reserved;
+
+    std::uint64_t strings;
+    std::uint64_t pairs;
+    std::uint64_t matchings;
+    std::uint64_t sources;
+
+    std::uint64_t string_offsets;
+    std::uint64_t characters;
+
+    std::uint64_t cheaters;
+    std::uint64_t authors;
+    std::uint64_t firsts;
+
+    std::uint64_t matching_pairs;
+    std::uint64_t cheated;
+    std::uint64_t confidences;
+    std::uint64_t offsets;
+
+    std::uint64_t source_strings;
+};
+
+/* Every column starts at a multiple of eight bytes */
+constexpr std::size_t alignment = 8;
+
+template <typename T>
+std::uint64_t column(std::ofstream& stream, const T* data, std::size_t count) {
+    auto offset = static_cast<std::uint64_t>(stream.tellp());
+
+    while (offset % alignment != 0) {
+        stream.put('\0');
+        offset += 1;
+    }
+
+    stream.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    return offset;
+}
+
+template <typename T>
+std::span<const T> section(const memmap::File& file, std::uint64_t offset, std::uint64_t count) {
+    if (offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+        constexpr auto detail = "The binary summary is corrupted";
+        throw std::runtime_error(detail);
+    }
+
+    return std::span<const T>(reinterpret_cast<const T*>(file.data() + offset), count);
+}
+
+/* The offsets start at zero, never decrease and end at the size of the column they index */
+bool monotonic(std::span<const std::uint64_t> offsets, std::uint64_t size) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != size) {
+        return false;
+    }
+
+    for (std::size_t idx = 1; idx < offsets.size(); ++idx) {
+        if (offsets[idx - 1] > offsets[idx]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool bounded(std::span<const std::uint32_t> ids, std::uint64_t size) {
+    for (auto id : ids) {
+        if (id >= size) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace __documents::summary::binary
+
+documents::summary::binary::Writer::Writer(const std::filesystem::path& path)
+    : path_(path), firsts_{0}, offsets_{0} {}
+
+void documents::summary::binary::Writer::pair(std::string_view cheater, std::string_view author) {
+    this->cheaters_.push_back(this->intern(cheater));
+    this->authors_.push_back(this->intern(author));
+    this->firsts_.push_back(this->firsts_.back());
+}
+
+void documents::summary::binary::Writer::matching(
+    std::string_view cheated,
+    double confidence,
+    const std::vector<std::string_view>& sources
+) {
+    if (this->cheaters_.empty()) {
+        constexpr auto detail = "The matching precedes any submission pair";
+        throw std::runtime_error(detail);
+    }
+
+    this->pairs_.push_back(static_cast<std::uint32_t>(this->cheaters_.size() - 1));
+    this->cheated_.push_back(this->intern(cheated));
+    this->confidences_.push_back(confidence);
+
+    for (const auto& source : sources) {
+        this->sources_.push_back(this->intern(source));
+    }
+
+    this->offsets_.push_back(this->sources_.size());
+    this->firsts_.back() += 1;
+}
+
+void documents::summary::binary::Writer::close(void) {
+    namespace binary = __documents::summary::binary;
+
+    std::ofstream stream(this->path_, std::ios::binary | std::ios::trunc);
+
+    if (!stream.is_open()) {
+        auto detail = std::format("Failed to open the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+
+    binary::Header header{};
+
+    header.magic = binary::magic;
+    header.strings = this->strings_.size();
+    header.pairs = this->cheaters_.size();
+    header.matchings = this->pairs_.size();
+    header.sources = this->sources_.size();
+
+    /* The header is rewritten once the columns are placed */
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<std::uint64_t> string_offsets{0};
+    std::string characters;
+
+    for (const auto* string : this->strings_) {
+        characters.append(*string);
+        string_offsets.push_back(characters.size());
+    }
+
+    header.string_offsets = binary::column(stream, string_offsets.data(), string_offsets.size());
+    header.characters = binary::column(stream, characters.data(), characters.size());
+
+    header.cheaters = binary::column(stream, this->cheaters_.data(), this->cheaters_.size());
+    header.authors = binary::column(stream, this->authors_.data(), this->authors_.size());
+    header.firsts = binary::column(stream, this->firsts_.data(), this->firsts_.size());
+
+    header.matching_pairs = binary::column(stream, this->pairs_.data(), this->pairs_.size());
+    header.cheated = binary::column(stream, this->cheated_.data(), this->cheated_.size());
+    header.confidences = binary::column(stream, this->confidences_.data(), this->confidences_.size());
+    header.offsets = binary::column(stream, this->offsets_.data(), this->offsets_.size());
+
+    header.source_strings = binary::column(stream, this->sources_.data(), this->sources_.size());
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    stream.close();
+
+    if (!stream) {
+        auto detail = std::format("Failed to write the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+}
+
+std::uint32_t documents::summary::binary::Writer::intern(std::string_view text) {
+    auto [iterator, inserted] = this->ids_.try_emplace(
+        std::string(text),
+        static_cast<std::uint32_t>(this->strings_.size()));
+
+    /* The keys of the map never move, so the table points to them */
+    if (inserted) {
+        this->strings_.push_back(&iterator->first);
+    }
+
+    return iterator->second;
+}
+
+documents::summary::binary::Reader::Reader(const std::filesystem::path& path) : file_(path) {
+    namespace binary = __documents::summary::binary;
+
+    auto detail = std::format("The binary summary {} is corrupted", path.string());
+
+    if (this->file_.size() < sizeof(binary::Header)) {
+        throw std::runtime_error(detail);
+    }
+
+    const auto* header = reinterpret_cast<const binary::Header*>(this->file_.data());
+
+    if (header->magic != binary::magic) {
+        throw std::runtime_error(detail);
+    }
+
+    /* The offset columns span one entry more than they index, so the counts must not wrap */
+    constexpr auto unbounded = std::numeric_limits<std::uint64_t>::max();
+
+    if (header->strings == unbounded || header->pairs == unbounded || header->matchings == unbounded) {
+        throw std::runtime_error(detail);
+    }
+
+    try {
+        this->string_offsets_ = binary::section<std::uint64_t>(
+            this->file_,
+            header->string_offsets,
+            header->strings + 1);
+
+        this->characters_ = binary::section<char>(
+            this->file_,
+            header->characters,
+            this->string_offsets_.back()).data();
+
+        this->cheaters_ = binary::section<std::uint32_t>(this->file_, header->cheaters, header->pairs);
+        this->authors_ = binary::section<std::uint32_t>(this->file_, header->authors, header->pairs);
+        this->firsts_ = binary::section<std::uint64_t>(this->file_, header->firsts, header->pairs + 1);
+
+        this->pairs_ = binary::section<std::uint32_t>(this->file_, header->matching_pairs, header->matchings);
+        this->cheated_ = binary::section<std::uint32_t>(this->file_, header->cheated, header->matchings);
+        this->confidences_ = binary::section<double>(this->file_, header->confidences, header->matchings);
+        this->offsets_ = binary::section<std::uint64_t>(this->file_, header->offsets, header->matchings + 1);
+
+        this->sources_ = binary::section<std::uint32_t>(this->file_, header->source_strings, header->sources);
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error(detail);
+    }
+
+    /* The accessors do not check the indices, so the columns are validated once */
+    auto valid = binary::monotonic(this->string_offsets_, this->string_offsets_.back())
+        && binary::monotonic(this->firsts_, header->matchings)
+        && binary::monotonic(this->offsets_, header->sources)
+        && binary::bounded(this->cheaters_, header->strings)
+        && binary::bounded(this->authors_, header->strings)
+        && binary::bounded(this->pairs_, header->pairs)
+        && binary::bounded(this->cheated_, header->strings)
+        && binary::bounded(this->sources_, header->strings);
+
+    if (!valid) {
+        throw std::runtime_error(detail);
+    }
+}
+
+std::size_t documents::summary::binary::Reader::pairs(void) const {
+    return this->cheaters_.size();
+}
+
+std::size_t documents::summary::binary::Reader::matchings(void) const {
+    return this->pairs_.size();
+}
+
+std::string_view documents::summary::binary::Reader::cheater(std::size_t pair) const {
+    return this->string(this->cheaters_[pair]);
+}
+
+std::string_view documents::summary::binary::Reader::author(std::size_t pair) const {
+    return this->string(this->authors_[pair]);
+}
+
+std::pair<std::size_t, std::size_t> documents::summary::binary::Reader::range(std::size_t pair) const {
+    return {this->firsts_[pair], this->firsts_[pair + 1]};
+}
+
+std::size_t documents::summary::binary::Reader::pair(std::size_t matching) const {
+    return this->pairs_[matching];
+}
+
+std::string_view documents::summary::binary::Reader::cheated(std::size_t matching) const {
+    return this->string(this->cheated_[matching]);
+}
+
+std::span<const double> documents::summary::binary::Reader::confidences(void) const {
+    return this->confidences_;
+}
+
+std::vector<std::string_view> documents::summary::binary::Reader::sources(std::size_t matching) const {
+    std::vector<std::string_view> sources;
+
+    for (auto idx = this->offsets_[matching]; idx < this->offsets_[matching + 1]; ++idx) {
+        sources.push_back(this->string(this->sources_[idx]));
+    }
+
+    return sources;
+}
+
+std::string_view documents::summary::binary::Reader::string(std::uint32_t id) const {
+    auto first = this->string_offsets_[id];
+    auto last = this->string_offsets_[id + 1];
+
+    return std::string_view(this->characters_ + first, last - first);
+}
@@ -0,0 +1,204 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DOCUMENTS_SUMMARY_BINARY_BINARY_HPP_
+#define SRC_DOCUMENTS_SUMMARY_BINARY_BINARY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lib/memmap/memmap.hpp"
+
+namespace documents::summary::binary {
+
+/**
+ * Writes the summary in the columnar layout.
+ * 
+ * @note the names are interned, a column holds one field of every pair or matching
+ * @note the columns are kept in memory and written on close
+*/
+class Writer {
+ public:
+    /**
+     * Creates an empty summary.
+     * 
+     * @param path the path to the file
+    */
+    explicit Writer(const std::filesystem::path& path);
+
+    /**
+     * Starts the comment on a submission pair.
+     * 
+     * @param cheater the name of the cheater submission
+     * @param author the name of the author submission
+    */
+    void pair(std::string_view cheater, std::string_view author);
+
+    /**
+     * Appends the matching to the last submission pair.
+     * 
+     * @param cheated the label of the cheated file
+     * @param confidence the probability of plagiarism
+     * @param sources the labels of the source files
+    */
+    void matching(
+        std::string_view cheated,
+        double confidence,
+        const std::vector<std::string_view>& sources);
+
+    /**
+     * Writes the columns to the file.
+    */
+    void close(void);
+
+ private:
+    std::filesystem::path path_;
+
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    std::vector<const std::string*> strings_;
+
+    std::vector<std::uint32_t> cheaters_;
+    std::vector<std::uint32_t> authors_;
+    std::vector<std::uint64_t> firsts_;
+
+    std::vector<std::uint32_t> pairs_;
+    std::vector<std::uint32_t> cheated_;
+    std::vector<double> confidences_;
+    std::vector<std::uint64_t> offsets_;
+
+    std::vector<std::uint32_t> sources_;
+
+    std::uint32_t intern(std::string_view text);
+};
+
+/**
+ * Read-only view of a columnar summary mapped into memory.
+ * 
+ * @note the matchings of a pair are consecutive, the pairs keep the order of the run
+*/
+class Reader {
+ public:
+    /**
+     * Maps and validates the summary.
+     * 
+     * @param path the path to the file
+    */
+    explicit Reader(const std::filesystem::path& path);
+
+    /**
+     * Returns the number of submission pairs.
+     * 
+     * @return the number of pairs
+    */
+    std::size_t pairs(void) const;
+
+    /**
+     * Returns the number of matchings.
+     * 
+     * @return the number of matchings
+    */
+    std::size_t matchings(void) const;
+
+    /**
+     * Returns the name of the cheater submission.
+     * 
+     * @param pair the index of the pair
+     * @return the name
+    */
+    std::string_view cheater(std::size_t pair) const;
+
+    /**
+     * Returns the name of the author submission.
+     * 
+     * @param pair the index of the pair
+     * @return the name
+    */
+    std::string_view author(std::size_t pair) const;
+
+    /**
+     * Returns the matchings of the submission pair.
+     * 
+     * @param pair the index of the pair
+     * @return the first and the past-the-last indices of the matchings
+    */
+    std::pair<std::size_t, std::size_t> range(std::size_t pair) const;
+
+    /**
+     * Returns the submission pair of the matching.
+     * 
+     * @param matching the index of the matching
+     * @return the index of the pair
+    */
+    std::size_t pair(std::size_t matching) const;
+
+    /**
+     * Returns the label of the cheated file.
+     * 
+     * @param matching the index of the matching
+     * @return the label
+    */
+    std::string_view cheated(std::size_t matching) const;
+
+    /**
+     * Returns the confidences of all the matchings.
+     * 
+     * @return the column of the confidences
+    */
+    std::span<const double> confidences(void) const;
+
+    /**
+     * Returns the labels of the source files.
+     * 
+     * @param matching the index of the matching
+     * @return the labels
+    */
+    std::vector<std::string_view> sources(std::size_t matching) const;
+
+ private:
+    memmap::File file_;
+
+    std::span<const std::uint64_t> string_offsets_;
+    const char* characters_ = nullptr;
+
+    std::span<const std::uint32_t> cheaters_;
+    std::span<const std::uint32_t> authors_;
+    std::span<const std::uint64_t> firsts_;
+
+    std::span<const std::uint32_t> pairs_;
+    std::span<const std::uint32_t> cheated_;
+    std::span<const double> confidences_;
+    std::span<const std::uint64_t> offsets_;
+
+    std::span<const std::uint32_t> sources_;
+
+    std::string_view string(std::uint32_t id) const;
+};
+
+}  // namespace documents::summary::binary
+
+#endif  // SRC_DOCUMENTS_SUMMARY_BINARY_BINARY_HPP_
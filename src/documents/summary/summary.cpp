@@ -20,12 +20,19 @@
 // limitations under the License.
 
 #include "src/documents/summary/summary.hpp"
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
 #include <experimental/embed>
 
+#include <rapidjson/schema.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 #include "lib/tempfile/tempfile.hpp"
 
 #include "src/ext/rapidjson/filesystem/filesystem.hpp"
@@ -35,6 +42,42 @@ namespace __documents::summary::specification {
 
 constexpr auto schema = std::embed("src/documents/summary/protocol.json");
 
+void inspect(std::string_view cheater, std::string_view author) {
+    if (cheater.empty()) {
+        constexpr auto detail = "The summary contains an empty cheater submission name";
+        throw std::runtime_error(detail);
+    }
+
+    if (author.empty()) {
+        constexpr auto detail = "The summary contains an empty author submission name";
+        throw std::runtime_error(detail);
+    }
+
+    if (cheater == author) {
+        constexpr auto detail = "The summary contains submissions that coincide in name";
+        throw std::runtime_error(detail);
+    }
+}
+
+void inspect(std::string_view cheated, double confidence) {
+    if (cheated.empty()) {
+        constexpr auto detail = "The summary contains a cheated file without path";
+        throw std::runtime_error(detail);
+    }
+
+    if (!(0.0 <= confidence && confidence <= 1.0)) {
+        constexpr auto detail = "The summary contains an invalid probability";
+        throw std::runtime_error(detail);
+    }
+}
+
+void inspect(std::string_view source) {
+    if (source.empty()) {
+        constexpr auto detail = "The summary contains an empty path as source";
+        throw std::runtime_error(detail);
+    }
+}
+
 void validate(const rapidjson::Document& document) {
     if (!rapidjson::schema::ok(document, schema)) {
         constexpr auto detail = "The summary does not match the schema";
@@ -44,48 +87,395 @@ void validate(const rapidjson::Document& document) {
     for (const auto& summary : document["summary"].GetArray()) {
         auto submissions = summary["submissions"].GetObject();
 
-        std::string cheater = submissions["cheater"].GetString();
-        if (cheater.empty()) {
-            constexpr auto detail = "The summary contains an empty cheater submission name";
-            throw std::runtime_error(detail);
+        inspect(submissions["cheater"].GetString(), submissions["author"].GetString());
+
+        for (const auto& matching : summary["matchings"].GetArray()) {
+            inspect(matching["cheated"].GetString(), matching["confidence"].GetDouble());
+
+            for (const auto& source : matching["sources"].GetArray()) {
+                inspect(source.GetString());
+            }
         }
+    }
+}
+
+}  // namespace __documents::summary::specification
+
+namespace __documents::summary::streaming {
 
-        std::string author = submissions["author"].GetString();
-        if (author.empty()) {
-            constexpr auto detail = "The summary contains an empty author submission name";
+using Writer = rapidjson::Writer<rapidjson::StringBuffer>;
+using Validator = rapidjson::GenericSchemaValidator<rapidjson::SchemaDocument, Writer>;
+
+/* The schema of a single comment, cut out of the protocol once */
+struct Protocol {
+    rapidjson::Document document;
+    std::unique_ptr<rapidjson::SchemaDocument> comment;
+
+    Protocol() {
+        if (this->document.Parse(specification::schema).HasParseError()) {
+            constexpr auto detail = "Failed to parse the JSON schema";
             throw std::runtime_error(detail);
         }
 
-        if (cheater == author) {
-            constexpr auto detail = "The summary contains submissions that coincide in name";
-            throw std::runtime_error(detail);
+        const auto& items = this->document["properties"]["summary"]["items"];
+        this->comment = std::make_unique<rapidjson::SchemaDocument>(items[rapidjson::SizeType{0}]);
+    }
+};
+
+const rapidjson::SchemaDocument& comment(void) {
+    static const Protocol protocol;
+    return *protocol.comment;
+}
+
+bool key(Validator& validator, std::string_view name) {
+    return validator.Key(name.data(), static_cast<rapidjson::SizeType>(name.size()), true);
+}
+
+bool string(Validator& validator, std::string_view text) {
+    return validator.String(text.data(), static_cast<rapidjson::SizeType>(text.size()), true);
+}
+
+/* The compressed records are flushed in blocks, each flush costs some ratio */
+constexpr std::size_t block = 1 << 16;
+
+void key(Writer& writer, std::string_view name) {
+    writer.Key(name.data(), static_cast<rapidjson::SizeType>(name.size()), true);
+}
+
+void string(Writer& writer, std::string_view text) {
+    writer.String(text.data(), static_cast<rapidjson::SizeType>(text.size()), true);
+}
+
+/* One self-contained record per matching, so that the lines can be consumed one by one */
+std::string records(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<documents::summary::Matching>& matchings
+) {
+    std::string lines;
+
+    rapidjson::StringBuffer buffer;
+    Writer writer;
+
+    for (const auto& matching : matchings) {
+        specification::inspect(matching.cheated, matching.confidence);
+
+        buffer.Clear();
+        writer.Reset(buffer);
+
+        writer.StartObject();
+
+        key(writer, "cheater");
+        string(writer, cheater);
+        key(writer, "author");
+        string(writer, author);
+        key(writer, "cheated");
+        string(writer, matching.cheated);
+        key(writer, "confidence");
+        writer.Double(matching.confidence);
+        key(writer, "sources");
+
+        writer.StartArray();
+        for (const auto& source : matching.sources) {
+            specification::inspect(source);
+            string(writer, source);
         }
+        writer.EndArray(static_cast<rapidjson::SizeType>(matching.sources.size()));
 
-        for (const auto& matching : summary["matchings"].GetArray()) {
-            std::string cheated = matching["cheated"].GetString();
-            if (cheated.empty()) {
-                constexpr auto detail = "The summary contains a cheated file without path";
-                throw std::runtime_error(detail);
-            }
+        writer.EndObject(5);
 
-            auto confidence = matching["confidence"].GetDouble();
-            if (!(0.0 <= confidence && confidence <= 1.0)) {
-                constexpr auto detail = "The summary contains an invalid probability";
-                throw std::runtime_error(detail);
-            }
+        lines.append(buffer.GetString(), buffer.GetSize());
+        lines.push_back('\n');
+    }
 
-            for (const auto& source : matching["sources"].GetArray()) {
-                std::string path = source.GetString();
-                if (path.empty()) {
-                    constexpr auto detail = "The summary contains an empty path as source";
-                    throw std::runtime_error(detail);
-                }
-            }
+    return lines;
+}
+
+}  // namespace __documents::summary::streaming
+
+namespace __documents::summary::packing {
+
+/* The fields of a comment travel from the workers to the columns as length-prefixed bytes */
+template <typename T>
+void put(std::string& packed, T value) {
+    packed.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put(std::string& packed, std::string_view text) {
+    put(packed, static_cast<std::uint32_t>(text.size()));
+    packed.append(text);
+}
+
+template <typename T>
+T take(std::string_view& packed) {
+    T value;
+
+    std::memcpy(&value, packed.data(), sizeof(value));
+    packed.remove_prefix(sizeof(value));
+
+    return value;
+}
+
+std::string_view text(std::string_view& packed) {
+    auto size = take<std::uint32_t>(packed);
+    auto value = packed.substr(0, size);
+
+    packed.remove_prefix(size);
+    return value;
+}
+
+std::string pack(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<documents::summary::Matching>& matchings
+) {
+    std::string packed;
+
+    put(packed, cheater);
+    put(packed, author);
+    put(packed, static_cast<std::uint32_t>(matchings.size()));
+
+    for (const auto& matching : matchings) {
+        specification::inspect(matching.cheated, matching.confidence);
+
+        put(packed, matching.cheated);
+        put(packed, matching.confidence);
+        put(packed, static_cast<std::uint32_t>(matching.sources.size()));
+
+        for (const auto& source : matching.sources) {
+            specification::inspect(source);
+            put(packed, source);
         }
     }
+
+    return packed;
 }
 
-}  // namespace __documents::summary::specification
+void unpack(std::string_view packed, documents::summary::binary::Writer& columns) {
+    auto cheater = text(packed);
+    auto author = text(packed);
+
+    columns.pair(cheater, author);
+
+    auto matchings = take<std::uint32_t>(packed);
+    std::vector<std::string_view> sources;
+
+    for (std::uint32_t idx = 0; idx < matchings; ++idx) {
+        auto cheated = text(packed);
+        auto confidence = take<double>(packed);
+
+        sources.resize(take<std::uint32_t>(packed));
+        for (auto& source : sources) {
+            source = text(packed);
+        }
+
+        columns.matching(cheated, confidence, sources);
+    }
+}
+
+}  // namespace __documents::summary::packing
+
+documents::summary::Format documents::summary::parse(const std::string& name) {
+    if (name == "json") {
+        return Format::json;
+    }
+
+    if (name == "jsonl") {
+        return Format::jsonl;
+    }
+
+    if (name == "binary") {
+        return Format::binary;
+    }
+
+    auto detail = std::format("Unknown summary format '{}'", name);
+    throw std::runtime_error(detail);
+}
+
+std::string documents::summary::comment(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<Matching>& matchings,
+    Format format
+) {
+    namespace specification = __documents::summary::specification;
+    namespace streaming = __documents::summary::streaming;
+
+    specification::inspect(cheater, author);
+
+    if (format == Format::jsonl) {
+        return streaming::records(cheater, author, matchings);
+    }
+
+    if (format == Format::binary) {
+        constexpr auto detail = "The binary summary takes packed comments";
+        throw std::runtime_error(detail);
+    }
+
+    rapidjson::StringBuffer buffer;
+    streaming::Writer writer(buffer);
+
+    /* The events pass the validator on their way to the writer */
+    streaming::Validator validator(streaming::comment(), writer);
+
+    auto ok = validator.StartObject()
+        && streaming::key(validator, "submissions")
+        && validator.StartObject()
+        && streaming::key(validator, "cheater")
+        && streaming::string(validator, cheater)
+        && streaming::key(validator, "author")
+        && streaming::string(validator, author)
+        && validator.EndObject(2)
+        && streaming::key(validator, "matchings")
+        && validator.StartArray();
+
+    for (const auto& matching : matchings) {
+        specification::inspect(matching.cheated, matching.confidence);
+
+        ok = ok
+            && validator.StartObject()
+            && streaming::key(validator, "cheated")
+            && streaming::string(validator, matching.cheated)
+            && streaming::key(validator, "confidence")
+            && validator.Double(matching.confidence)
+            && streaming::key(validator, "sources")
+            && validator.StartArray();
+
+        for (const auto& source : matching.sources) {
+            specification::inspect(source);
+            ok = ok && streaming::string(validator, source);
+        }
+
+        ok = ok
+            && validator.EndArray(static_cast<rapidjson::SizeType>(matching.sources.size()))
+            && validator.EndObject(3);
+    }
+
+    ok = ok
+        && validator.EndArray(static_cast<rapidjson::SizeType>(matchings.size()))
+        && validator.EndObject(2);
+
+    if (!ok || !validator.IsValid()) {
+        constexpr auto detail = "The summary does not match the schema";
+        throw std::runtime_error(detail);
+    }
+
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+documents::summary::Packed documents::summary::pack(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<Matching>& matchings
+) {
+    __documents::summary::specification::inspect(cheater, author);
+    return Packed{__documents::summary::packing::pack(cheater, author, matchings)};
+}
+
+documents::summary::Stream::Stream(
+    const std::filesystem::path& path,
+    Format format,
+    compression::Codec codec
+) : format_(format), codec_(codec) {
+    if (format == Format::binary) {
+        if (codec != compression::Codec::none) {
+            constexpr auto detail = "The binary summary cannot be compressed";
+            throw std::runtime_error(detail);
+        }
+
+        this->columns_ = std::make_unique<binary::Writer>(path);
+        return;
+    }
+
+    this->text_ = std::make_unique<compression::Writer>(path, codec);
+
+    if (format == Format::json) {
+        this->text_->write(R"({"summary":[)");
+    }
+}
+
+void documents::summary::Stream::write(const std::string& comment) {
+    if (this->format_ == Format::binary) {
+        constexpr auto detail = "The binary summary takes packed comments";
+        throw std::runtime_error(detail);
+    }
+
+    if (this->format_ == Format::json && !this->empty_) {
+        this->text_->write(",");
+    }
+
+    this->text_->write(comment);
+    this->empty_ = false;
+
+    if (this->format_ == Format::json) {
+        return;
+    }
+
+    /* The plain records are visible at once, the compressed ones block by block */
+    this->pending_ += comment.size();
+
+    if (this->codec_ == compression::Codec::none || this->pending_ >= __documents::summary::streaming::block) {
+        this->text_->flush();
+        this->pending_ = 0;
+    }
+}
+
+void documents::summary::Stream::write(const Packed& comment) {
+    if (this->format_ != Format::binary) {
+        constexpr auto detail = "The packed comments are written to the binary summary only";
+        throw std::runtime_error(detail);
+    }
+
+    __documents::summary::packing::unpack(comment.bytes, *this->columns_);
+}
+
+void documents::summary::Stream::close(void) {
+    if (this->format_ == Format::binary) {
+        this->columns_->close();
+        return;
+    }
+
+    if (this->format_ == Format::json) {
+        this->text_->write("]}");
+    }
+
+    this->text_->close();
+}
+
+void documents::summary::convert(
+    const std::filesystem::path& source,
+    const std::filesystem::path& destination,
+    Format format,
+    compression::Codec codec
+) {
+    if (format == Format::binary) {
+        constexpr auto detail = "The binary summary is converted to JSON or JSON Lines only";
+        throw std::runtime_error(detail);
+    }
+
+    binary::Reader reader(source);
+    Stream stream(destination, format, codec);
+
+    std::vector<Matching> matchings;
+
+    /* The comments pass the same validation as the ones of a run */
+    for (std::size_t pair = 0; pair < reader.pairs(); ++pair) {
+        auto [first, last] = reader.range(pair);
+
+        matchings.clear();
+
+        for (auto matching = first; matching < last; ++matching) {
+            matchings.push_back(Matching{
+                reader.cheated(matching),
+                reader.confidences()[matching],
+                reader.sources(matching)});
+        }
+
+        stream.write(comment(reader.cheater(pair), reader.author(pair), matchings, format));
+    }
+
+    stream.close();
+}
 
 std::filesystem::path documents::summary::write_json(const rapidjson::Document& summary) {
     __documents::summary::specification::validate(summary);
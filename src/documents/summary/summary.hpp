@@ -24,11 +24,163 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <rapidjson/document.h>
 
+#include "lib/compression/compression.hpp"
+
+#include "src/documents/summary/binary/binary.hpp"
+
 namespace documents::summary {
 
+/**
+ * Layout of the summary file.
+ * 
+ * @note `json` is a single document, `jsonl` is one record per matching
+ * @note `binary` is the columnar layout read by `binary::Reader`
+*/
+enum class Format {
+    json,
+    jsonl,
+    binary,
+};
+
+/**
+ * Parses the name of the layout.
+ * 
+ * @param name the name, e.g. `jsonl`
+ * @return the layout
+*/
+Format parse(const std::string& name);
+
+/**
+ * Matching of a cheated file with its sources.
+ * 
+ * @param cheated the label of the cheated file
+ * @param confidence the probability of plagiarism
+ * @param sources the labels of the source files
+*/
+struct Matching {
+    std::string_view cheated;
+    double confidence;
+    std::vector<std::string_view> sources;
+};
+
+/**
+ * Serializes the comment on a submission pair, validating it against the schema.
+ * 
+ * @param cheater the name of the cheater submission
+ * @param author the name of the author submission
+ * @param matchings the matchings in the order of appearance
+ * @param format the layout of the summary file, `json` or `jsonl`
+ * @return the `JSON` of the comment, or its records terminated by newlines
+ * 
+ * @note thread-safe
+ * @note the `binary` comments are serialized by `pack`
+*/
+std::string comment(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<Matching>& matchings,
+    Format format = Format::json);
+
+/**
+ * Comment on a submission pair, packed for the `binary` layout.
+ * 
+ * @param bytes the length-prefixed fields of the comment
+ * 
+ * @note the labels are copied, so that the comment outlives the matchings
+*/
+struct Packed {
+    std::string bytes;
+};
+
+/**
+ * Packs the comment on a submission pair for the `binary` layout, validating its fields.
+ * 
+ * @param cheater the name of the cheater submission
+ * @param author the name of the author submission
+ * @param matchings the matchings in the order of appearance
+ * @return the packed comment
+ * 
+ * @note thread-safe
+*/
+Packed pack(
+    std::string_view cheater,
+    std::string_view author,
+    const std::vector<Matching>& matchings);
+
+/**
+ * Writes the configuration of the `summary` type to a file, one comment at a time.
+ * 
+ * @note the comments are never held in memory together
+ * @note the records of `jsonl` become readable as soon as they are written
+ * @note the `binary` layout is never compressed, so that it may be mapped
+*/
+class Stream {
+ public:
+    /**
+     * Opens the file and starts the summary.
+     * 
+     * @param path the path to the file
+     * @param format the layout of the summary file
+     * @param codec the compression of the summary file
+    */
+    Stream(
+        const std::filesystem::path& path,
+        Format format = Format::json,
+        compression::Codec codec = compression::Codec::none);
+
+    /**
+     * Appends the comment serialized by `comment` in the same format.
+     * 
+     * @param comment the serialized comment
+     * 
+     * @note the `binary` summary takes the comments packed by `pack`
+    */
+    void write(const std::string& comment);
+
+    /**
+     * Appends the comment packed by `pack` to the `binary` summary.
+     * 
+     * @param comment the packed comment
+    */
+    void write(const Packed& comment);
+
+    /**
+     * Finishes the summary and closes the file.
+    */
+    void close(void);
+
+ private:
+    Format format_;
+    compression::Codec codec_;
+
+    std::unique_ptr<compression::Writer> text_;
+    std::unique_ptr<binary::Writer> columns_;
+
+    bool empty_ = true;
+    std::size_t pending_ = 0;
+};
+
+/**
+ * Converts the `binary` summary back to the `JSON` protocol.
+ * 
+ * @param source the path to the `binary` summary
+ * @param destination the path to the converted summary
+ * @param format the layout of the converted summary, `json` or `jsonl`
+ * @param codec the compression of the converted summary
+*/
+void convert(
+    const std::filesystem::path& source,
+    const std::filesystem::path& destination,
+    Format format = Format::json,
+    compression::Codec codec = compression::Codec::none);
+
 /**
  * Writes the configuration of the `summary` type as a `JSON` file.
  * 
@@ -0,0 +1,160 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/compression/compression.hpp"
+#include "lib/logging/logging.hpp"
+
+#include "src/documents/summary/binary/binary.hpp"
+#include "src/documents/summary/summary.hpp"
+
+namespace __documents::summary::test {
+
+const auto directory = std::filesystem::temp_directory_path() / "gelada-summary-test";
+
+struct Comment {
+    std::string_view cheater;
+    std::string_view author;
+    std::vector<documents::summary::Matching> matchings;
+};
+
+/* The labels repeat across the comments, and a pair may have no matchings */
+const std::vector<Comment> comments{
+    {"alice", "bob", {
+        {"main.py", 0.875, {"main.py", "utils.py"}},
+        {"utils.py", 0.5, {"utils.py"}},
+    }},
+    {"carol", "alice", {}},
+    {"carol", "bob", {
+        {"main.py", 1.0, {"main.py"}},
+    }},
+};
+
+std::string read(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+void write(const std::filesystem::path& path, documents::summary::Format format) {
+    documents::summary::Stream stream(path, format);
+
+    for (const auto& comment : comments) {
+        if (format == documents::summary::Format::binary) {
+            stream.write(documents::summary::pack(comment.cheater, comment.author, comment.matchings));
+        } else {
+            stream.write(documents::summary::comment(comment.cheater, comment.author, comment.matchings, format));
+        }
+    }
+
+    stream.close();
+}
+
+/* The columns hold the comments in the order they were packed */
+bool columnar(const std::filesystem::path& path) {
+    documents::summary::binary::Reader reader(path);
+
+    if (reader.pairs() != comments.size() || reader.matchings() != 3) {
+        return false;
+    }
+
+    for (std::size_t pair = 0; pair < reader.pairs(); ++pair) {
+        const auto& comment = comments[pair];
+        auto [first, last] = reader.range(pair);
+
+        if (reader.cheater(pair) != comment.cheater
+            || reader.author(pair) != comment.author
+            || last - first != comment.matchings.size()) {
+            return false;
+        }
+
+        for (auto matching = first; matching < last; ++matching) {
+            const auto& expected = comment.matchings[matching - first];
+            auto sources = reader.sources(matching);
+
+            auto same = reader.pair(matching) == pair
+                && reader.cheated(matching) == expected.cheated
+                && reader.confidences()[matching] == expected.confidence
+                && std::vector<std::string_view>(sources.begin(), sources.end()) == expected.sources;
+
+            if (!same) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* The converted summary is the one a run would have written in that format */
+bool converted(const std::filesystem::path& packed, documents::summary::Format format) {
+    auto direct = directory / "direct.txt";
+    auto conversion = directory / "converted.txt";
+
+    write(direct, format);
+    documents::summary::convert(packed, conversion, format, compression::Codec::none);
+
+    return read(direct) == read(conversion);
+}
+
+}  // namespace __documents::summary::test
+
+int main() {
+    namespace test = __documents::summary::test;
+
+    try {
+        std::filesystem::remove_all(test::directory);
+        std::filesystem::create_directories(test::directory);
+
+        auto packed = test::directory / "summary.bin";
+        test::write(packed, documents::summary::Format::binary);
+
+        if (!test::columnar(packed)) {
+            logging::error("The binary summary differs from the packed comments");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::converted(packed, documents::summary::Format::json)) {
+            logging::error("The binary summary converts to another JSON summary");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::converted(packed, documents::summary::Format::jsonl)) {
+            logging::error("The binary summary converts to another JSON Lines summary");
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove_all(test::directory);
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
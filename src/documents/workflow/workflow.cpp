@@ -21,6 +21,8 @@
 
 #include "src/documents/workflow/workflow.hpp"
 
+#include <charconv>
+#include <cstdint>
 #include <format>
 #include <stdexcept>
 #include <string>
@@ -81,6 +83,24 @@ void validate(const rapidjson::Document& workflow) {
         }
     }
 
+    if (workflow.HasMember("boilerplate") && workflow["boilerplate"].HasMember("path")) {
+        std::string path = workflow["boilerplate"]["path"].GetString();
+        if (path.empty()) {
+            constexpr auto detail = "The workflow boilerplate has an empty path";
+            throw std::runtime_error(detail);
+        }
+    }
+
+    if (workflow.HasMember("filter")) {
+        const auto& filter = workflow["filter"];
+
+        auto has_range = filter.HasMember("min_size") && filter.HasMember("max_size");
+        if (has_range && filter["min_size"].GetUint64() > filter["max_size"].GetUint64()) {
+            constexpr auto detail = "The workflow filter has a minimum size above the maximum one";
+            throw std::runtime_error(detail);
+        }
+    }
+
     if (submissions.size() <= 1) {
         constexpr auto detail = "There must be at least two submissions within the workflow";
         throw std::runtime_error(detail);
@@ -89,6 +109,93 @@ void validate(const rapidjson::Document& workflow) {
 
 }  // namespace __documents::workflow::specification
 
+namespace __documents::workflow::typing {
+
+/* Gives the string the type declared by the schema, if the text spells a value of the type */
+void coerce(rapidjson::Value& value, const std::string& type) {
+    std::string text = value.GetString();
+
+    auto first = text.data() + (text.starts_with('+') ? 1 : 0);
+    auto last = text.data() + text.size();
+
+    if (type == "boolean" && (text == "true" || text == "false")) {
+        value.SetBool(text == "true");
+        return;
+    }
+
+    if (type == "integer" || type == "number") {
+        std::int64_t integer = 0;
+
+        auto [end, error] = std::from_chars(first, last, integer);
+        if (error == std::errc{} && end == last) {
+            value.SetInt64(integer);
+            return;
+        }
+    }
+
+    if (type == "number") {
+        double number = 0.0;
+
+        auto [end, error] = std::from_chars(first, last, number);
+        if (error == std::errc{} && end == last) {
+            value.SetDouble(number);
+        }
+    }
+}
+
+/* Walks the document along the schema, the mismatches are left to the validation */
+void walk(rapidjson::Value& value, const rapidjson::Value& schema) {
+    if (schema.HasMember("oneOf")) {
+        for (const auto& alternative : schema["oneOf"].GetArray()) {
+            walk(value, alternative);
+        }
+    }
+
+    if (!schema.HasMember("type")) {
+        return;
+    }
+
+    std::string type = schema["type"].GetString();
+
+    if (type == "object" && value.IsObject() && schema.HasMember("properties")) {
+        const auto& properties = schema["properties"];
+
+        for (auto& member : value.GetObject()) {
+            if (properties.HasMember(member.name)) {
+                walk(member.value, properties[member.name]);
+            }
+        }
+
+        return;
+    }
+
+    if (type == "array" && value.IsArray() && schema.HasMember("items")) {
+        for (auto& item : value.GetArray()) {
+            walk(item, schema["items"]);
+        }
+
+        return;
+    }
+
+    if (value.IsString()) {
+        coerce(value, type);
+    }
+}
+
+/* The scalars of YAML are strings, so the ones declared otherwise are typed by the schema */
+void apply(rapidjson::Document& workflow) {
+    rapidjson::Document sd;
+
+    if (sd.Parse(__documents::workflow::specification::schema).HasParseError()) {
+        constexpr auto detail = "Failed to parse the JSON schema";
+        throw std::runtime_error(detail);
+    }
+
+    walk(workflow, sd);
+}
+
+}  // namespace __documents::workflow::typing
+
 rapidjson::Document documents::workflow::read(const std::filesystem::path& path) {
     rapidjson::Document workflow;
 
@@ -99,6 +206,7 @@ rapidjson::Document documents::workflow::read(const std::filesystem::path& path)
 
     } else if (extension == ".yaml" || extension == ".yml") {
         workflow = adapters::to_rapidjson::read_yaml(path);
+        __documents::workflow::typing::apply(workflow);
 
     } else if (!path.has_extension()) {
         constexpr auto detail = "The workflow does not have an extension";
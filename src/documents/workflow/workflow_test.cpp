@@ -0,0 +1,82 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+
+#include <rapidjson/document.h>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/documents/workflow/workflow.hpp"
+
+namespace __documents::workflow::test {
+
+const std::filesystem::path yaml = "src/documents/workflow/testdata/workflow.yaml";
+const std::filesystem::path json = "src/documents/workflow/testdata/workflow.json";
+
+/* The fields declared numeric or boolean are typed, the names stay strings whatever they spell */
+bool typed(const rapidjson::Document& workflow) {
+    const auto& boilerplate = workflow["boilerplate"];
+    const auto& filter = workflow["filter"];
+    const auto& submissions = workflow["submissions"];
+
+    for (const auto& submission : submissions.GetArray()) {
+        if (!submission["name"].IsString()) {
+            return false;
+        }
+    }
+
+    return boilerplate["frequency"].IsDouble()
+        && filter["min_size"].IsUint64()
+        && filter["max_size"].IsUint64()
+        && filter["binary"].IsBool()
+        && submissions[rapidjson::SizeType{0}]["suspect"].IsBool()
+        && submissions[rapidjson::SizeType{1}]["suspect"].IsBool();
+}
+
+}  // namespace __documents::workflow::test
+
+int main() {
+    namespace test = __documents::workflow::test;
+
+    try {
+        auto from_yaml = documents::workflow::read(test::yaml);
+        auto from_json = documents::workflow::read(test::json);
+
+        if (!test::typed(from_yaml)) {
+            logging::error("The YAML workflow has mistyped scalars");
+            return EXIT_FAILURE;
+        }
+
+        if (from_yaml != from_json) {
+            logging::error("The YAML and JSON workflows differ");
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
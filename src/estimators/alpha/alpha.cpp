@@ -22,13 +22,228 @@
 #include "src/estimators/alpha/alpha.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
-
-#include <levenshtein/levenshtein.hpp>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "lib/pathlib/pathlib.hpp"
 
+#include "src/fingerprints/fingerprints.hpp"
+#include "src/kernels/kernels.hpp"
+
+namespace __estimators::alpha::tiling {
+
+constexpr std::uint64_t base = 0x100000001B3ULL;
+
+/* The first search length, longer matches restart the scan */
+constexpr std::size_t search = 32;
+
+struct Match {
+    std::size_t lhs;
+    std::size_t rhs;
+    std::size_t length;
+};
+
+/**
+ * Unmarked stream of tokens with the prefix hashes.
+*/
+class Stream {
+ public:
+    explicit Stream(const std::vector<std::uint32_t>& tokens)
+        : tokens_(tokens), marked_(tokens.size(), false), prefix_(tokens.size() + 1, 0) {
+        for (std::size_t idx = 0; idx < tokens.size(); ++idx) {
+            this->prefix_[idx + 1] = this->prefix_[idx] * base + tokens[idx] + 1;
+        }
+    }
+
+    std::size_t size() const {
+        return this->tokens_.size();
+    }
+
+    std::uint32_t at(std::size_t idx) const {
+        return this->tokens_[idx];
+    }
+
+    bool marked(std::size_t idx) const {
+        return this->marked_[idx];
+    }
+
+    void mark(std::size_t start, std::size_t length) {
+        std::fill_n(this->marked_.begin() + start, length, true);
+    }
+
+    bool occluded(std::size_t start, std::size_t length) const {
+        auto first = this->marked_.begin() + start;
+        return std::find(first, first + length, true) != first + length;
+    }
+
+    /* Returns the hashes of the unmarked windows of the length */
+    std::vector<std::pair<std::uint64_t, std::size_t>> windows(std::size_t length) const {
+        std::vector<std::pair<std::uint64_t, std::size_t>> hashes;
+
+        if (length > this->size()) {
+            return hashes;
+        }
+
+        std::uint64_t power = 1;
+        for (std::size_t idx = 0; idx < length; ++idx) {
+            power *= base;
+        }
+
+        /* The number of unmarked tokens ending at the position */
+        std::size_t run = 0;
+
+        for (std::size_t idx = 0; idx < this->size(); ++idx) {
+            run = this->marked_[idx] ? 0 : run + 1;
+
+            if (run >= length) {
+                auto start = idx + 1 - length;
+                auto hash = this->prefix_[idx + 1] - this->prefix_[start] * power;
+                hashes.emplace_back(hash, start);
+            }
+        }
+
+        return hashes;
+    }
+
+ private:
+    const std::vector<std::uint32_t>& tokens_;
+    std::vector<bool> marked_;
+    std::vector<std::uint64_t> prefix_;
+};
+
+/* Finds the maximal matches of at least the length, returns the longest one */
+std::size_t scan(
+    const Stream& pattern,
+    const Stream& text,
+    std::size_t length,
+    std::vector<Match>& matches
+) {
+    auto index = text.windows(length);
+    std::sort(index.begin(), index.end());
+
+    std::size_t longest = 0;
+
+    for (const auto& [hash, lhs] : pattern.windows(length)) {
+        auto first = std::lower_bound(
+            index.begin(),
+            index.end(),
+            std::pair<std::uint64_t, std::size_t>{hash, 0});
+
+        for (auto it = first; it != index.end() && it->first == hash; ++it) {
+            auto rhs = it->second;
+            std::size_t extent = 0;
+
+            /* Hashes may collide, so the tokens are compared anyway */
+            while (lhs + extent < pattern.size()
+                && rhs + extent < text.size()
+                && !pattern.marked(lhs + extent)
+                && !text.marked(rhs + extent)
+                && pattern.at(lhs + extent) == text.at(rhs + extent)) {
+                extent += 1;
+            }
+
+            if (extent < length) {
+                continue;
+            }
+
+            /* Much longer matches are searched with the longer windows */
+            if (extent > 2 * length) {
+                return extent;
+            }
+
+            longest = std::max(longest, extent);
+            matches.push_back({lhs, rhs, extent});
+        }
+    }
+
+    return longest;
+}
+
+/* Marks the non-overlapping matches as tiles, returns the number of covered tokens */
+std::size_t mark(Stream& pattern, Stream& text, std::vector<Match>& matches) {
+    auto comparator = [](const Match& lhs, const Match& rhs) {
+        return lhs.length > rhs.length;
+    };
+    std::stable_sort(matches.begin(), matches.end(), comparator);
+
+    std::size_t covered = 0;
+
+    for (const auto& match : matches) {
+        if (pattern.occluded(match.lhs, match.length)) {
+            continue;
+        }
+
+        if (text.occluded(match.rhs, match.length)) {
+            continue;
+        }
+
+        pattern.mark(match.lhs, match.length);
+        text.mark(match.rhs, match.length);
+        covered += match.length;
+    }
+
+    matches.clear();
+
+    return covered;
+}
+
+}  // namespace __estimators::alpha::tiling
+
+namespace __estimators::alpha::parallel {
+
+/* A tile is 16 blocks of 64 symbols high and 4096 symbols wide */
+constexpr std::size_t height = 16;
+constexpr std::size_t width = 4096;
+
+std::atomic<bool> busy = false;
+
+/* The tiles of an anti-diagonal, claimed one by one by the caller and the idle workers */
+struct Diagonal {
+    kernels::Grid* grid;
+    std::size_t diagonal;
+    std::size_t last;
+    std::size_t tiles;
+
+    std::atomic<std::size_t> next;
+    std::atomic<std::size_t> done = 0;
+
+    std::mutex mutex{};
+    std::condition_variable finished{};
+    std::exception_ptr failure{};
+};
+
+/* Computes the unclaimed tiles, a late worker finds none and never touches the grid */
+void work(Diagonal& state) {
+    for (auto row = state.next++; row < state.last; row = state.next++) {
+        try {
+            state.grid->compute(row, state.diagonal - row);
+        }
+        catch (...) {
+            std::lock_guard lock(state.mutex);
+
+            if (!state.failure) {
+                state.failure = std::current_exception();
+            }
+        }
+
+        if (++state.done == state.tiles) {
+            std::lock_guard lock(state.mutex);
+            state.finished.notify_all();
+        }
+    }
+}
+
+}  // namespace __estimators::alpha::parallel
+
 double estimators::alpha::levenshtein(
     const std::filesystem::path& lhs,
     const std::filesystem::path& rhs
@@ -36,12 +251,178 @@ double estimators::alpha::levenshtein(
     auto lhs_text = pathlib::read_text(lhs);
     auto rhs_text = pathlib::read_text(rhs);
 
+    return estimators::alpha::levenshtein(lhs_text, rhs_text);
+}
+
+double estimators::alpha::levenshtein(const std::string& lhs, const std::string& rhs) {
+    if (lhs.empty() && rhs.empty()) {
+        return 1.0;
+    }
+
+    auto distance = kernels::levenshtein(lhs, rhs);
+    auto maxlen = std::max(lhs.length(), rhs.length());
+
+    return 1.0 - static_cast<double>(distance) / maxlen;
+}
+
+std::vector<double> estimators::alpha::levenshtein(
+    const std::string& lhs,
+    const std::vector<const std::string*>& candidates
+) {
+    std::vector<std::string_view> views;
+    views.reserve(candidates.size());
+
+    for (const auto* candidate : candidates) {
+        views.emplace_back(*candidate);
+    }
+
+    auto distances = kernels::levenshtein(lhs, views);
+
+    std::vector<double> scores(candidates.size());
+
+    for (std::size_t idx = 0; idx < candidates.size(); ++idx) {
+        auto maxlen = std::max(lhs.length(), candidates[idx]->length());
+
+        scores[idx] = (maxlen == 0)
+            ? 1.0
+            : 1.0 - static_cast<double>(distances[idx]) / maxlen;
+    }
+
+    return scores;
+}
+
+double estimators::alpha::winnowing(
+    const std::vector<std::uint64_t>& lhs,
+    const std::vector<std::uint64_t>& rhs
+) {
+    if (lhs.empty() && rhs.empty()) {
+        return 1.0;
+    }
+
+    auto shared = fingerprints::overlap(lhs, rhs);
+    auto maxlen = std::max(lhs.size(), rhs.size());
+
+    return static_cast<double>(shared) / maxlen;
+}
+
+double estimators::alpha::gst(
+    const std::vector<std::uint32_t>& lhs,
+    const std::vector<std::uint32_t>& rhs,
+    std::size_t minimum
+) {
+    if (minimum == 0) {
+        constexpr auto detail = "The minimum tile length must be positive";
+        throw std::runtime_error(detail);
+    }
+
     if (lhs.empty() && rhs.empty()) {
         return 1.0;
     }
 
-    auto distance = levenshtein::levenshtein<std::string>(lhs_text, rhs_text);
-    auto maxlen = std::max(lhs_text.length(), rhs_text.length());
+    /* The shorter stream is the pattern, the longer one is indexed */
+    const auto& shorter = lhs.size() <= rhs.size() ? lhs : rhs;
+    const auto& longer = lhs.size() <= rhs.size() ? rhs : lhs;
+
+    __estimators::alpha::tiling::Stream pattern(shorter);
+    __estimators::alpha::tiling::Stream text(longer);
+
+    std::vector<__estimators::alpha::tiling::Match> matches;
+
+    std::size_t covered = 0;
+    auto length = std::max(minimum, __estimators::alpha::tiling::search);
+
+    /* Running-Karp-Rabin Greedy String Tiling */
+    while (true) {
+        auto longest = __estimators::alpha::tiling::scan(pattern, text, length, matches);
+
+        if (longest > 2 * length) {
+            matches.clear();
+            length = longest;
+            continue;
+        }
+
+        covered += __estimators::alpha::tiling::mark(pattern, text, matches);
+
+        if (length > 2 * minimum) {
+            length /= 2;
+        } else if (length > minimum) {
+            length = minimum;
+        } else {
+            break;
+        }
+    }
+
+    auto total = lhs.size() + rhs.size();
+
+    return 2.0 * static_cast<double>(covered) / static_cast<double>(total);
+}
+
+double estimators::alpha::parallel::levenshtein(
+    const std::string& lhs,
+    const std::string& rhs,
+    BS::thread_pool& pool
+) {
+    auto shortest = std::min(lhs.length(), rhs.length());
+
+    if (pool.get_thread_count() <= 1 || shortest <= estimators::alpha::parallel::threshold) {
+        return estimators::alpha::levenshtein(lhs, rhs);
+    }
+
+    /* The workers share the tiles of one comparison at a time */
+    if (__estimators::alpha::parallel::busy.exchange(true)) {
+        return estimators::alpha::levenshtein(lhs, rhs);
+    }
+
+    struct Release {
+        ~Release() {
+            __estimators::alpha::parallel::busy.store(false);
+        }
+    } release;
+
+    kernels::Grid grid(
+        lhs,
+        rhs,
+        __estimators::alpha::parallel::height,
+        __estimators::alpha::parallel::width);
+
+    auto threads = pool.get_thread_count();
+
+    auto rows = grid.rows();
+    auto columns = grid.columns();
+
+    /* The tiles of an anti-diagonal depend only on the previous one */
+    for (std::size_t diagonal = 0; diagonal + 1 < rows + columns; ++diagonal) {
+        auto first = (diagonal < columns) ? 0 : diagonal - columns + 1;
+        auto last = std::min(diagonal + 1, rows);
+
+        /* The state outlives the call, as the queued workers may start after it returns */
+        auto state = std::make_shared<__estimators::alpha::parallel::Diagonal>();
+
+        state->grid = &grid;
+        state->diagonal = diagonal;
+        state->last = last;
+        state->tiles = last - first;
+        state->next = first;
+
+        for (std::size_t helper = 1; helper < std::min(threads, state->tiles); ++helper) {
+            pool.detach_task([state]{
+                __estimators::alpha::parallel::work(*state);
+            });
+        }
+
+        __estimators::alpha::parallel::work(*state);
+
+        /* The grid is shared, so every claimed tile finishes before any rethrow */
+        std::unique_lock lock(state->mutex);
+        state->finished.wait(lock, [&state]{ return state->done == state->tiles; });
+
+        if (state->failure) {
+            std::rethrow_exception(state->failure);
+        }
+    }
+
+    auto distance = grid.distance();
+    auto maxlen = std::max(lhs.length(), rhs.length());
 
     return 1.0 - static_cast<double>(distance) / maxlen;
 }
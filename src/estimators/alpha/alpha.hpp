@@ -22,7 +22,13 @@
 #ifndef SRC_ESTIMATORS_ALPHA_ALPHA_HPP_
 #define SRC_ESTIMATORS_ALPHA_ALPHA_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
 
 namespace estimators::alpha {
 
@@ -37,6 +43,85 @@ namespace estimators::alpha {
 */
 double levenshtein(const std::filesystem::path& lhs, const std::filesystem::path& rhs);
 
+/**
+ * Returns a similarity score based on the `Levenshtein` algorithm.
+ * 
+ * @param lhs the text to be compared
+ * @param rhs the text to be compared
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+*/
+double levenshtein(const std::string& lhs, const std::string& rhs);
+
+/**
+ * Returns the similarity scores of the text and every candidate based on the
+ * `Levenshtein` algorithm.
+ * 
+ * @param lhs the text to be compared
+ * @param candidates the texts to be compared with `lhs`
+ * @return the similarity scores, in the order of the candidates
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note computes several candidates per kernel invocation
+*/
+std::vector<double> levenshtein(const std::string& lhs, const std::vector<const std::string*>& candidates);
+
+/**
+ * Returns a similarity score based on the overlap of winnowed fingerprints.
+ * 
+ * @param lhs the sorted unique fingerprints to be compared
+ * @param rhs the sorted unique fingerprints to be compared
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note runs in linear time
+*/
+double winnowing(const std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs);
+
+/**
+ * Returns a similarity score based on the `Greedy String Tiling` algorithm.
+ * 
+ * @param lhs the token stream to be compared
+ * @param rhs the token stream to be compared
+ * @param minimum the minimum length of a tile, in tokens
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note insensitive to the reordering of blocks longer than the minimum
+ * @note runs in near-linear time unless the streams are highly repetitive
+*/
+double gst(
+    const std::vector<std::uint32_t>& lhs,
+    const std::vector<std::uint32_t>& rhs,
+    std::size_t minimum);
+
 }  // namespace estimators::alpha
 
+namespace estimators::alpha::parallel {
+
+/**
+ * The length both texts must exceed to be compared by several threads.
+*/
+constexpr std::size_t threshold = 32768;
+
+/**
+ * Returns a similarity score based on the `Levenshtein` algorithm.
+ * 
+ * @param lhs the text to be compared
+ * @param rhs the text to be compared
+ * @param pool the pool of the calling worker
+ * @return the similarity score
+ * 
+ * @note the metric ranges from `0` to `1`
+ * @note the matrix is split into tiles computed by anti-diagonals
+ * @note the calling thread shares the tiles with the workers of the pool once they are idle,
+ * so no thread is spawned beyond the pool
+ * @note shorter texts, or a comparison started while another one is running,
+ * are compared by the calling thread
+*/
+double levenshtein(const std::string& lhs, const std::string& rhs, BS::thread_pool& pool);
+
+}  // namespace estimators::alpha::parallel
+
 #endif  // SRC_ESTIMATORS_ALPHA_ALPHA_HPP_
@@ -0,0 +1,144 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/fingerprints/fingerprints.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <stdexcept>
+
+#include "src/kernels/kernels.hpp"
+
+namespace __fingerprints::rolling {
+
+constexpr std::uint64_t base = 0x100000001B3ULL;
+
+}  // namespace __fingerprints::rolling
+
+std::vector<std::uint64_t> fingerprints::winnow(
+    const std::string& text,
+    std::size_t k,
+    std::size_t window
+) {
+    if (k == 0) {
+        constexpr auto detail = "The k-gram length must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    if (window == 0) {
+        constexpr auto detail = "The window must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    std::string stripped;
+    stripped.reserve(text.size());
+
+    for (auto symbol : text) {
+        if (!std::isspace(static_cast<unsigned char>(symbol))) {
+            stripped.push_back(symbol);
+        }
+    }
+
+    if (stripped.size() < k) {
+        return {};
+    }
+
+    std::uint64_t power = 1;
+    for (std::size_t idx = 1; idx < k; ++idx) {
+        power *= __fingerprints::rolling::base;
+    }
+
+    std::uint64_t hash = 0;
+    for (std::size_t idx = 0; idx < k; ++idx) {
+        hash = hash * __fingerprints::rolling::base + static_cast<unsigned char>(stripped[idx]);
+    }
+
+    auto count = stripped.size() - k + 1;
+
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(count);
+    hashes.push_back(hash);
+
+    for (std::size_t idx = k; idx < stripped.size(); ++idx) {
+        hash -= power * static_cast<unsigned char>(stripped[idx - k]);
+        hash = hash * __fingerprints::rolling::base + static_cast<unsigned char>(stripped[idx]);
+        hashes.push_back(hash);
+    }
+
+    /* Scrambles the polynomial hashes so that minima are spread uniformly */
+    kernels::mix(hashes);
+
+    std::vector<std::uint64_t> selected;
+
+    /* Monotonic queue of the window minima, the rightmost one wins ties */
+    std::deque<std::size_t> minima;
+    std::size_t last = count;
+
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        while (!minima.empty() && hashes[minima.back()] >= hashes[idx]) {
+            minima.pop_back();
+        }
+        minima.push_back(idx);
+
+        if (minima.front() + window <= idx) {
+            minima.pop_front();
+        }
+
+        if (idx + 1 < window && idx + 1 != count) {
+            continue;
+        }
+
+        if (minima.front() != last) {
+            last = minima.front();
+            selected.push_back(hashes[last]);
+        }
+    }
+
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    return selected;
+}
+
+std::size_t fingerprints::overlap(
+    const std::vector<std::uint64_t>& lhs,
+    const std::vector<std::uint64_t>& rhs
+) {
+    std::size_t shared = 0;
+
+    auto left = lhs.begin();
+    auto right = rhs.begin();
+
+    while (left != lhs.end() && right != rhs.end()) {
+        if (*left < *right) {
+            ++left;
+        } else if (*right < *left) {
+            ++right;
+        } else {
+            ++shared;
+            ++left;
+            ++right;
+        }
+    }
+
+    return shared;
+}
@@ -0,0 +1,65 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_FINGERPRINTS_FINGERPRINTS_HPP_
+#define SRC_FINGERPRINTS_FINGERPRINTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fingerprints::defaults {
+
+constexpr std::size_t k = 24;
+constexpr std::size_t window = 16;
+
+}  // namespace fingerprints::defaults
+
+namespace fingerprints {
+
+/**
+ * Selects the fingerprints of the text using the winnowing algorithm.
+ * 
+ * @param text the text to be fingerprinted
+ * @param k the length of the hashed k-grams
+ * @param window the number of consecutive k-grams per window
+ * @return the sorted unique fingerprints
+ * 
+ * @note whitespace is skipped, so layout changes do not affect the result
+ * @note every match of at least `k + window - 1` characters shares a fingerprint
+*/
+std::vector<std::uint64_t> winnow(const std::string& text, std::size_t k, std::size_t window);
+
+/**
+ * Counts the fingerprints shared by two sets.
+ * 
+ * @param lhs the sorted unique fingerprints
+ * @param rhs the sorted unique fingerprints
+ * @return the size of the intersection
+ * 
+ * @note runs in linear time
+*/
+std::size_t overlap(const std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs);
+
+}  // namespace fingerprints
+
+#endif  // SRC_FINGERPRINTS_FINGERPRINTS_HPP_
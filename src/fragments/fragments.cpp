@@ -0,0 +1,345 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/fragments/fragments.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace __fragments::suffixes {
+
+constexpr std::uint32_t nobody = std::numeric_limits<std::uint32_t>::max();
+
+/* Prefix doubling over the cyclic shifts, the text must end with a unique zero */
+std::vector<std::uint32_t> sort(const std::vector<std::uint32_t>& text, std::size_t alphabet) {
+    auto size = text.size();
+
+    std::vector<std::uint32_t> order(size);
+    std::vector<std::uint32_t> classes(size);
+    std::vector<std::uint32_t> count(std::max(alphabet, size), 0);
+
+    for (auto symbol : text) {
+        count[symbol] += 1;
+    }
+
+    for (std::size_t idx = 1; idx < count.size(); ++idx) {
+        count[idx] += count[idx - 1];
+    }
+
+    for (auto idx = size; idx-- > 0;) {
+        order[--count[text[idx]]] = static_cast<std::uint32_t>(idx);
+    }
+
+    std::size_t number = 1;
+    classes[order[0]] = 0;
+
+    for (std::size_t idx = 1; idx < size; ++idx) {
+        if (text[order[idx]] != text[order[idx - 1]]) {
+            number += 1;
+        }
+        classes[order[idx]] = static_cast<std::uint32_t>(number - 1);
+    }
+
+    std::vector<std::uint32_t> shifted(size);
+    std::vector<std::uint32_t> reclassed(size);
+
+    for (std::size_t half = 1; half < size && number < size; half <<= 1) {
+        for (std::size_t idx = 0; idx < size; ++idx) {
+            shifted[idx] = static_cast<std::uint32_t>((order[idx] + size - half) % size);
+        }
+
+        /* The shifts are already sorted by their second halves */
+        std::fill_n(count.begin(), number, 0);
+
+        for (auto shift : shifted) {
+            count[classes[shift]] += 1;
+        }
+
+        for (std::size_t idx = 1; idx < number; ++idx) {
+            count[idx] += count[idx - 1];
+        }
+
+        for (auto idx = size; idx-- > 0;) {
+            order[--count[classes[shifted[idx]]]] = shifted[idx];
+        }
+
+        number = 1;
+        reclassed[order[0]] = 0;
+
+        for (std::size_t idx = 1; idx < size; ++idx) {
+            auto current = std::make_pair(classes[order[idx]], classes[(order[idx] + half) % size]);
+            auto previous = std::make_pair(
+                classes[order[idx - 1]],
+                classes[(order[idx - 1] + half) % size]);
+
+            if (current != previous) {
+                number += 1;
+            }
+            reclassed[order[idx]] = static_cast<std::uint32_t>(number - 1);
+        }
+
+        classes.swap(reclassed);
+    }
+
+    return order;
+}
+
+/* Kasai et al., the prefix shared with the previous suffix */
+std::vector<std::uint32_t> lcp(
+    const std::vector<std::uint32_t>& text,
+    const std::vector<std::uint32_t>& order
+) {
+    auto size = text.size();
+
+    std::vector<std::uint32_t> ranks(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        ranks[order[idx]] = static_cast<std::uint32_t>(idx);
+    }
+
+    std::vector<std::uint32_t> shared(size, 0);
+    std::size_t length = 0;
+
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        if (ranks[idx] == 0) {
+            length = 0;
+            continue;
+        }
+
+        auto previous = order[ranks[idx] - 1];
+
+        while (idx + length < size
+            && previous + length < size
+            && text[idx + length] == text[previous + length]) {
+            length += 1;
+        }
+
+        shared[ranks[idx]] = static_cast<std::uint32_t>(length);
+
+        if (length > 0) {
+            length -= 1;
+        }
+    }
+
+    return shared;
+}
+
+}  // namespace __fragments::suffixes
+
+namespace __fragments::coverage {
+
+/* Both indices fit into 32 bits */
+std::uint64_t key(std::size_t lhs, std::size_t rhs) {
+    return (static_cast<std::uint64_t>(lhs) << 32) | static_cast<std::uint64_t>(rhs);
+}
+
+std::size_t unite(std::vector<std::pair<std::uint32_t, std::uint32_t>>& intervals) {
+    std::sort(intervals.begin(), intervals.end());
+
+    std::size_t covered = 0;
+    std::uint32_t end = 0;
+
+    for (const auto& [start, length] : intervals) {
+        auto stop = start + length;
+
+        if (stop <= end) {
+            continue;
+        }
+
+        covered += stop - std::max(start, end);
+        end = stop;
+    }
+
+    return covered;
+}
+
+}  // namespace __fragments::coverage
+
+fragments::Index::Index(
+    const std::vector<const std::vector<std::uint32_t>*>& streams,
+    const std::vector<std::size_t>& groups
+) : groups_(groups) {
+    if (streams.size() != groups.size()) {
+        constexpr auto detail = "Every stream must belong to a group";
+        throw std::runtime_error(detail);
+    }
+
+    std::size_t total = 1;
+    for (const auto* stream : streams) {
+        total += stream->size() + 1;
+    }
+
+    if (total >= __fragments::suffixes::nobody) {
+        constexpr auto detail = "The streams are too long for the suffix array";
+        throw std::runtime_error(detail);
+    }
+
+    /* Tokens are ranked densely above the unique separators */
+    std::vector<std::uint32_t> alphabet;
+    for (const auto* stream : streams) {
+        alphabet.insert(alphabet.end(), stream->begin(), stream->end());
+    }
+
+    std::sort(alphabet.begin(), alphabet.end());
+    alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+
+    auto separators = streams.size();
+
+    this->text_.reserve(total);
+    this->owners_.reserve(total);
+
+    for (std::size_t idx = 0; idx < streams.size(); ++idx) {
+        this->starts_.push_back(static_cast<std::uint32_t>(this->text_.size()));
+        this->lengths_.push_back(static_cast<std::uint32_t>(streams[idx]->size()));
+
+        for (auto token : *streams[idx]) {
+            auto rank = std::lower_bound(alphabet.begin(), alphabet.end(), token) - alphabet.begin();
+            this->text_.push_back(static_cast<std::uint32_t>(separators + 1 + rank));
+            this->owners_.push_back(static_cast<std::uint32_t>(idx));
+        }
+
+        this->text_.push_back(static_cast<std::uint32_t>(idx + 1));
+        this->owners_.push_back(__fragments::suffixes::nobody);
+    }
+
+    this->text_.push_back(0);
+    this->owners_.push_back(__fragments::suffixes::nobody);
+
+    this->suffixes_ = __fragments::suffixes::sort(this->text_, separators + 1 + alphabet.size());
+    this->lcp_ = __fragments::suffixes::lcp(this->text_, this->suffixes_);
+}
+
+std::vector<fragments::Fragment> fragments::Index::enumerate(
+    std::size_t minimum,
+    std::size_t limit
+) const {
+    if (minimum == 0) {
+        constexpr auto detail = "The minimum fragment length must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    std::vector<fragments::Fragment> found;
+
+    for (std::size_t idx = 0; idx < this->suffixes_.size(); ++idx) {
+        auto lhs_position = this->suffixes_[idx];
+        auto lhs = this->owners_[lhs_position];
+
+        if (lhs == __fragments::suffixes::nobody) {
+            continue;
+        }
+
+        /* The prefix shared with every next suffix is the minimum of the LCP between */
+        auto shared = std::numeric_limits<std::uint32_t>::max();
+
+        for (auto next = idx + 1; next < this->suffixes_.size() && next - idx <= limit; ++next) {
+            shared = std::min(shared, this->lcp_[next]);
+
+            if (shared < minimum) {
+                break;
+            }
+
+            auto rhs_position = this->suffixes_[next];
+            auto rhs = this->owners_[rhs_position];
+
+            if (this->groups_[lhs] == this->groups_[rhs]) {
+                continue;
+            }
+
+            /* The separators are unique, so equal predecessors are tokens of a longer fragment */
+            if (lhs_position > 0
+                && rhs_position > 0
+                && this->text_[lhs_position - 1] == this->text_[rhs_position - 1]) {
+                continue;
+            }
+
+            found.push_back({
+                lhs,
+                lhs_position - this->starts_[lhs],
+                rhs,
+                rhs_position - this->starts_[rhs],
+                shared});
+        }
+    }
+
+    return found;
+}
+
+std::size_t fragments::Index::size() const {
+    return this->lengths_.size();
+}
+
+std::size_t fragments::Index::length(std::size_t stream) const {
+    return this->lengths_.at(stream);
+}
+
+fragments::Coverage::Coverage(
+    const fragments::Index& index,
+    const std::vector<fragments::Fragment>& fragments
+) {
+    for (std::size_t idx = 0; idx < index.size(); ++idx) {
+        this->lengths_.push_back(index.length(idx));
+    }
+
+    using Intervals = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+    /* The intervals of the smaller and the larger stream of every pair */
+    std::unordered_map<std::uint64_t, std::pair<Intervals, Intervals>> covers;
+
+    for (const auto& fragment : fragments) {
+        auto swap = fragment.rhs < fragment.lhs;
+
+        auto lhs = swap ? fragment.rhs : fragment.lhs;
+        auto rhs = swap ? fragment.lhs : fragment.rhs;
+        auto lhs_offset = swap ? fragment.rhs_offset : fragment.lhs_offset;
+        auto rhs_offset = swap ? fragment.lhs_offset : fragment.rhs_offset;
+
+        auto& [lhs_intervals, rhs_intervals] = covers[__fragments::coverage::key(lhs, rhs)];
+        lhs_intervals.emplace_back(lhs_offset, fragment.length);
+        rhs_intervals.emplace_back(rhs_offset, fragment.length);
+    }
+
+    for (auto& [key, intervals] : covers) {
+        auto lhs = static_cast<std::size_t>(key >> 32);
+        auto rhs = static_cast<std::size_t>(key & 0xFFFFFFFFULL);
+
+        auto covered = __fragments::coverage::unite(intervals.first)
+            + __fragments::coverage::unite(intervals.second);
+        auto total = this->lengths_[lhs] + this->lengths_[rhs];
+
+        this->scores_[key] = static_cast<double>(covered) / static_cast<double>(total);
+    }
+}
+
+double fragments::Coverage::score(std::size_t lhs, std::size_t rhs) const {
+    if (this->lengths_.at(lhs) == 0 && this->lengths_.at(rhs) == 0) {
+        return 1.0;
+    }
+
+    auto key = __fragments::coverage::key(std::min(lhs, rhs), std::max(lhs, rhs));
+
+    auto iterator = this->scores_.find(key);
+    if (iterator == this->scores_.end()) {
+        return 0.0;
+    }
+
+    return iterator->second;
+}
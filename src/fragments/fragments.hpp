@@ -0,0 +1,145 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_FRAGMENTS_FRAGMENTS_HPP_
+#define SRC_FRAGMENTS_FRAGMENTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fragments::defaults {
+
+/* Suffixes compared with every suffix of a block of equal prefixes */
+constexpr std::size_t limit = 64;
+
+}  // namespace fragments::defaults
+
+namespace fragments {
+
+/**
+ * Maximal run of tokens shared by two streams.
+ * 
+ * @param lhs the index of the first stream
+ * @param lhs_offset the offset of the run in the first stream
+ * @param rhs the index of the second stream
+ * @param rhs_offset the offset of the run in the second stream
+ * @param length the number of tokens in the run
+*/
+struct Fragment {
+    std::uint32_t lhs;
+    std::uint32_t lhs_offset;
+    std::uint32_t rhs;
+    std::uint32_t rhs_offset;
+    std::uint32_t length;
+};
+
+/**
+ * Generalized suffix array over the token streams of all files.
+ * 
+ * @note the streams are separated by unique sentinels, so no match crosses them
+*/
+class Index {
+ public:
+    /**
+     * Builds the suffix and LCP arrays of the streams.
+     * 
+     * @param streams the token streams
+     * @param groups the group of every stream, e.g. the submission
+     * 
+     * @note runs in `O(n log n)` time, where `n` is the total number of tokens
+    */
+    Index(
+        const std::vector<const std::vector<std::uint32_t>*>& streams,
+        const std::vector<std::size_t>& groups);
+
+    /**
+     * Enumerates the maximal fragments shared by streams of different groups.
+     * 
+     * @param minimum the minimum length of a fragment, in tokens
+     * @param limit the number of neighbouring suffixes compared with each suffix
+     * @return the fragments
+     * 
+     * @note runs in `O(n * limit)` time, linear for the default limit
+     * @note blocks of more than `limit` equal suffixes are boilerplate, they are covered only partially
+    */
+    std::vector<Fragment> enumerate(
+        std::size_t minimum,
+        std::size_t limit = defaults::limit) const;
+
+    /**
+     * Returns the number of the streams.
+    */
+    std::size_t size() const;
+
+    /**
+     * Returns the length of the stream.
+     * 
+     * @param stream the index of the stream
+     * @return the number of tokens
+    */
+    std::size_t length(std::size_t stream) const;
+
+ private:
+    std::vector<std::uint32_t> text_;
+    std::vector<std::uint32_t> owners_;
+    std::vector<std::uint32_t> starts_;
+    std::vector<std::uint32_t> lengths_;
+    std::vector<std::size_t> groups_;
+
+    std::vector<std::uint32_t> suffixes_;
+    std::vector<std::uint32_t> lcp_;
+};
+
+/**
+ * Similarity of the stream pairs according to their shared fragments.
+*/
+class Coverage {
+ public:
+    /**
+     * Turns the fragments into the scores of the stream pairs.
+     * 
+     * @param index the index the fragments were enumerated from
+     * @param fragments the shared fragments
+    */
+    Coverage(const Index& index, const std::vector<Fragment>& fragments);
+
+    /**
+     * Returns the share of the tokens of both streams covered by their fragments.
+     * 
+     * @param lhs the index of the stream
+     * @param rhs the index of the stream
+     * @return the similarity score
+     * 
+     * @note the metric ranges from `0` to `1`
+     * @note symmetric
+    */
+    double score(std::size_t lhs, std::size_t rhs) const;
+
+ private:
+    std::vector<std::size_t> lengths_;
+    std::unordered_map<std::uint64_t, double> scores_;
+};
+
+}  // namespace fragments
+
+#endif  // SRC_FRAGMENTS_FRAGMENTS_HPP_
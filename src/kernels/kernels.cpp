@@ -0,0 +1,407 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/kernels/kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <stdexcept>
+
+#include "src/kernels/variants.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GELADA_KERNELS_X86_64
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+static_assert(kernels::lanes == __kernels::lanes);
+
+namespace __kernels::dispatch {
+
+struct Table {
+    std::int64_t (*tile)(
+        const std::uint64_t*,
+        std::size_t,
+        std::uint64_t*,
+        std::uint64_t*,
+        std::int8_t*,
+        std::string_view,
+        std::size_t,
+        std::size_t,
+        std::size_t);
+    std::size_t (*levenshtein)(std::string_view, std::string_view);
+    void (*batch)(std::string_view, const std::string_view*, std::size_t, std::size_t*);
+    std::size_t (*bounded)(std::string_view, std::string_view, std::size_t);
+    std::size_t (*mismatches)(const char*, const char*, std::size_t);
+    std::size_t (*overlap)(const std::size_t*, const std::size_t*, std::size_t);
+    void (*mix)(std::uint64_t*, std::size_t);
+};
+
+constexpr Table scalar{
+    __kernels::scalar::tile,
+    __kernels::scalar::levenshtein,
+    __kernels::scalar::levenshtein,
+    __kernels::scalar::bounded,
+    __kernels::scalar::mismatches,
+    __kernels::scalar::overlap,
+    __kernels::scalar::mix,
+};
+
+constexpr Table sse42{
+    __kernels::sse42::tile,
+    __kernels::sse42::levenshtein,
+    __kernels::sse42::levenshtein,
+    __kernels::sse42::bounded,
+    __kernels::sse42::mismatches,
+    __kernels::sse42::overlap,
+    __kernels::sse42::mix,
+};
+
+constexpr Table avx2{
+    __kernels::avx2::tile,
+    __kernels::avx2::levenshtein,
+    __kernels::avx2::levenshtein,
+    __kernels::avx2::bounded,
+    __kernels::avx2::mismatches,
+    __kernels::avx2::overlap,
+    __kernels::avx2::mix,
+};
+
+constexpr Table avx512{
+    __kernels::avx512::tile,
+    __kernels::avx512::levenshtein,
+    __kernels::avx512::levenshtein,
+    __kernels::avx512::bounded,
+    __kernels::avx512::mismatches,
+    __kernels::avx512::overlap,
+    __kernels::avx512::mix,
+};
+
+const Table& table(kernels::Variant variant) {
+    switch (variant) {
+        case kernels::Variant::sse42:
+            return sse42;
+        case kernels::Variant::avx2:
+            return avx2;
+        case kernels::Variant::avx512:
+            return avx512;
+        default:
+            return scalar;
+    }
+}
+
+/* Selected on the first call, unless the user has already chosen */
+std::atomic<kernels::Variant>& current() {
+    static std::atomic<kernels::Variant> variant{kernels::detect()};
+    return variant;
+}
+
+}  // namespace __kernels::dispatch
+
+namespace __kernels::cpuid {
+
+#ifdef GELADA_KERNELS_X86_64
+
+struct Registers {
+    std::uint32_t eax;
+    std::uint32_t ebx;
+    std::uint32_t ecx;
+    std::uint32_t edx;
+};
+
+Registers query(std::uint32_t leaf, std::uint32_t subleaf) {
+    Registers registers{0, 0, 0, 0};
+
+#ifdef _MSC_VER
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+
+    registers.eax = static_cast<std::uint32_t>(values[0]);
+    registers.ebx = static_cast<std::uint32_t>(values[1]);
+    registers.ecx = static_cast<std::uint32_t>(values[2]);
+    registers.edx = static_cast<std::uint32_t>(values[3]);
+#else
+    if (leaf > __get_cpuid_max(0, nullptr)) {
+        return registers;
+    }
+
+    __cpuid_count(leaf, subleaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif
+
+    return registers;
+}
+
+/* The register states the OS saves on a context switch */
+std::uint64_t xcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    std::uint32_t eax = 0;
+    std::uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+constexpr bool bit(std::uint32_t value, unsigned idx) {
+    return (value >> idx) & 1;
+}
+
+#endif
+
+bool sse42() {
+#ifdef GELADA_KERNELS_X86_64
+    auto basic = query(1, 0);
+    return bit(basic.ecx, 20) && bit(basic.ecx, 23);
+#else
+    return false;
+#endif
+}
+
+bool avx2() {
+#ifdef GELADA_KERNELS_X86_64
+    auto basic = query(1, 0);
+
+    /* OSXSAVE, AVX */
+    if (!sse42() || !bit(basic.ecx, 27) || !bit(basic.ecx, 28)) {
+        return false;
+    }
+
+    /* XMM and YMM states */
+    if ((xcr0() & 0x6) != 0x6) {
+        return false;
+    }
+
+    /* AVX2, BMI2 */
+    auto extended = query(7, 0);
+    return bit(extended.ebx, 5) && bit(extended.ebx, 8);
+#else
+    return false;
+#endif
+}
+
+bool avx512() {
+#ifdef GELADA_KERNELS_X86_64
+    if (!avx2()) {
+        return false;
+    }
+
+    /* Opmask and ZMM states */
+    if ((xcr0() & 0xE6) != 0xE6) {
+        return false;
+    }
+
+    /* AVX512F, AVX512DQ, AVX512BW, AVX512VL */
+    auto extended = query(7, 0);
+    return bit(extended.ebx, 16) && bit(extended.ebx, 17) && bit(extended.ebx, 30) && bit(extended.ebx, 31);
+#else
+    return false;
+#endif
+}
+
+}  // namespace __kernels::cpuid
+
+std::string kernels::name(Variant variant) {
+    switch (variant) {
+        case Variant::sse42:
+            return "sse42";
+        case Variant::avx2:
+            return "avx2";
+        case Variant::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+kernels::Variant kernels::parse(const std::string& name) {
+    for (auto variant : {Variant::scalar, Variant::sse42, Variant::avx2, Variant::avx512}) {
+        if (kernels::name(variant) == name) {
+            return variant;
+        }
+    }
+
+    auto detail = std::format("The kernel variant '{}' is unknown", name);
+    throw std::runtime_error(detail);
+}
+
+bool kernels::supported(Variant variant) {
+    switch (variant) {
+        case Variant::sse42:
+            return __kernels::cpuid::sse42();
+        case Variant::avx2:
+            return __kernels::cpuid::avx2();
+        case Variant::avx512:
+            return __kernels::cpuid::avx512();
+        default:
+            return true;
+    }
+}
+
+kernels::Variant kernels::detect() {
+    for (auto variant : {Variant::avx512, Variant::avx2, Variant::sse42}) {
+        if (kernels::supported(variant)) {
+            return variant;
+        }
+    }
+
+    return Variant::scalar;
+}
+
+void kernels::select(Variant variant) {
+    if (!kernels::supported(variant)) {
+        auto detail = std::format("The kernel variant '{}' is not supported by the processor", kernels::name(variant));
+        throw std::runtime_error(detail);
+    }
+
+    __kernels::dispatch::current().store(variant);
+}
+
+kernels::Variant kernels::active() {
+    return __kernels::dispatch::current().load();
+}
+
+std::size_t kernels::levenshtein(std::string_view lhs, std::string_view rhs) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+    return table.levenshtein(lhs, rhs);
+}
+
+std::size_t kernels::levenshtein(std::string_view lhs, std::string_view rhs, std::size_t limit) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+    return table.bounded(lhs, rhs, limit);
+}
+
+kernels::Grid::Grid(std::string_view lhs, std::string_view rhs, std::size_t height, std::size_t width)
+    : height_(height), width_(width), delta_(0) {
+    if (height == 0 || width == 0) {
+        constexpr auto detail = "The size of a tile must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    /* The common affixes do not change the distance */
+    while (!lhs.empty() && !rhs.empty() && lhs.front() == rhs.front()) {
+        lhs.remove_prefix(1);
+        rhs.remove_prefix(1);
+    }
+
+    while (!lhs.empty() && !rhs.empty() && lhs.back() == rhs.back()) {
+        lhs.remove_suffix(1);
+        rhs.remove_suffix(1);
+    }
+
+    this->pattern_ = (lhs.size() <= rhs.size()) ? lhs : rhs;
+    this->text_ = (lhs.size() <= rhs.size()) ? rhs : lhs;
+
+    constexpr std::size_t word = 64;
+
+    this->blocks_ = (this->pattern_.size() + word - 1) / word;
+
+    this->peq_.assign(256 * this->blocks_, 0);
+    for (std::size_t idx = 0; idx < this->pattern_.size(); ++idx) {
+        auto byte = static_cast<unsigned char>(this->pattern_[idx]);
+        this->peq_[byte * this->blocks_ + idx / word] |= std::uint64_t{1} << (idx % word);
+    }
+
+    /* Both the first column and the first row grow by one */
+    this->positive_.assign(this->blocks_, ~std::uint64_t{0});
+    this->negative_.assign(this->blocks_, 0);
+    this->carries_.assign(this->text_.size(), 1);
+}
+
+std::size_t kernels::Grid::rows() const {
+    return (this->blocks_ + this->height_ - 1) / this->height_;
+}
+
+std::size_t kernels::Grid::columns() const {
+    return (this->text_.size() + this->width_ - 1) / this->width_;
+}
+
+void kernels::Grid::compute(std::size_t row, std::size_t column) {
+    if (row >= this->rows() || column >= this->columns()) {
+        constexpr auto detail = "The tile is out of the grid";
+        throw std::runtime_error(detail);
+    }
+
+    const auto& table = __kernels::dispatch::table(kernels::active());
+
+    auto first = row * this->height_;
+    auto last = std::min(first + this->height_, this->blocks_);
+
+    auto offset = column * this->width_;
+    auto text = this->text_.substr(offset, this->width_);
+
+    auto delta = table.tile(
+        this->peq_.data(),
+        this->blocks_,
+        this->positive_.data(),
+        this->negative_.data(),
+        this->carries_.data() + offset,
+        text,
+        first,
+        last,
+        (this->pattern_.size() - 1) % 64);
+
+    this->delta_ += delta;
+}
+
+std::size_t kernels::Grid::distance() const {
+    if (this->pattern_.empty()) {
+        return this->text_.size();
+    }
+
+    return static_cast<std::size_t>(static_cast<std::int64_t>(this->pattern_.size()) + this->delta_.load());
+}
+
+std::vector<std::size_t> kernels::levenshtein(
+    std::string_view query,
+    const std::vector<std::string_view>& candidates
+) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+
+    std::vector<std::size_t> distances(candidates.size());
+
+    for (std::size_t first = 0; first < candidates.size(); first += kernels::lanes) {
+        auto count = std::min(kernels::lanes, candidates.size() - first);
+        table.batch(query, candidates.data() + first, count, distances.data() + first);
+    }
+
+    return distances;
+}
+
+std::size_t kernels::mismatches(std::string_view lhs, std::string_view rhs) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+    return table.mismatches(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+}
+
+std::size_t kernels::overlap(const std::array<std::size_t, 256>& lhs, const std::array<std::size_t, 256>& rhs) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+    return table.overlap(lhs.data(), rhs.data(), lhs.size());
+}
+
+void kernels::mix(std::vector<std::uint64_t>& hashes) {
+    const auto& table = __kernels::dispatch::table(kernels::active());
+    table.mix(hashes.data(), hashes.size());
+}
@@ -0,0 +1,229 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_KERNELS_KERNELS_HPP_
+#define SRC_KERNELS_KERNELS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kernels {
+
+/**
+ * The number of candidates compared by one batched call.
+*/
+constexpr std::size_t lanes = 8;
+
+/**
+ * The instruction sets the kernels are compiled for.
+*/
+enum class Variant {
+    scalar,
+    sse42,
+    avx2,
+    avx512,
+};
+
+/**
+ * Returns the name of the variant.
+ * 
+ * @param variant the variant
+ * @return the name, e.g. `avx2`
+*/
+std::string name(Variant variant);
+
+/**
+ * Parses the name of the variant.
+ * 
+ * @param name the name, e.g. `avx2`
+ * @return the variant
+ * 
+ * @throw std::runtime_error if the name is unknown
+*/
+Variant parse(const std::string& name);
+
+/**
+ * Checks if the processor and the OS support the variant.
+ * 
+ * @param variant the variant
+ * @return `true` if the variant can be used, otherwise `false`
+ * 
+ * @note Determined by CPUID, the scalar variant is always supported.
+*/
+bool supported(Variant variant);
+
+/**
+ * Returns the best variant supported by the processor.
+ * 
+ * @return the variant
+*/
+Variant detect();
+
+/**
+ * Uses the variant for all further calls.
+ * 
+ * @param variant the variant
+ * 
+ * @throw std::runtime_error if the variant is not supported
+ * 
+ * @note Until it is called, the detected variant is used.
+*/
+void select(Variant variant);
+
+/**
+ * Returns the variant in use.
+ * 
+ * @return the variant
+*/
+Variant active();
+
+/**
+ * Computes the Levenshtein distance of the byte strings.
+ * 
+ * @param lhs the first string
+ * @param rhs the second string
+ * @return the unit-cost edit distance
+ * 
+ * @note Bit-parallel, 64 cells of the matrix per word.
+*/
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs);
+
+/**
+ * Computes the Levenshtein distance of the byte strings, if it is small.
+ * 
+ * @param lhs the first string
+ * @param rhs the second string
+ * @param limit the largest distance of interest
+ * @return the unit-cost edit distance, or `limit + 1` if it exceeds the limit
+ * 
+ * @note Only the `2 * limit + 1` diagonals of the matrix are computed, one cell at a time.
+*/
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs, std::size_t limit);
+
+/**
+ * The Levenshtein matrix of two strings, split into tiles computed separately.
+ * 
+ * @note A tile can be computed once the tiles above and to the left of it are,
+ * so the tiles of an anti-diagonal may be computed in parallel.
+*/
+class Grid {
+ public:
+    /**
+     * Prepares the matrix, the strings must outlive it.
+     * 
+     * @param lhs the first string
+     * @param rhs the second string
+     * @param height the number of 64-symbol blocks of the shorter string per tile
+     * @param width the number of symbols of the longer string per tile
+    */
+    Grid(std::string_view lhs, std::string_view rhs, std::size_t height, std::size_t width);
+
+    /**
+     * Returns the number of rows of tiles.
+     * 
+     * @return the number of rows
+    */
+    std::size_t rows() const;
+
+    /**
+     * Returns the number of columns of tiles.
+     * 
+     * @return the number of columns
+    */
+    std::size_t columns() const;
+
+    /**
+     * Computes the tile.
+     * 
+     * @param row the row of the tile
+     * @param column the column of the tile
+    */
+    void compute(std::size_t row, std::size_t column);
+
+    /**
+     * Returns the distance, once every tile is computed.
+     * 
+     * @return the unit-cost edit distance
+    */
+    std::size_t distance() const;
+
+ private:
+    std::string_view pattern_;
+    std::string_view text_;
+
+    std::size_t blocks_;
+    std::size_t height_;
+    std::size_t width_;
+
+    std::vector<std::uint64_t> peq_;
+    std::vector<std::uint64_t> positive_;
+    std::vector<std::uint64_t> negative_;
+    std::vector<std::int8_t> carries_;
+
+    std::atomic<std::int64_t> delta_;
+};
+
+/**
+ * Computes the Levenshtein distances of the query to every candidate.
+ * 
+ * @param query the string compared with every candidate
+ * @param candidates the candidates
+ * @return the unit-cost edit distances, in the order of the candidates
+ * 
+ * @note The candidates are compared in batches of `lanes`, one per SIMD lane.
+*/
+std::vector<std::size_t> levenshtein(std::string_view query, const std::vector<std::string_view>& candidates);
+
+/**
+ * Computes the Hamming distance of the equally long prefixes of the strings.
+ * 
+ * @param lhs the first string
+ * @param rhs the second string
+ * @return the number of positions where the strings differ
+ * 
+ * @note The symbols past the shorter string are ignored.
+*/
+std::size_t mismatches(std::string_view lhs, std::string_view rhs);
+
+/**
+ * Computes the sum of the element-wise minima of the histograms.
+ * 
+ * @param lhs the first histogram
+ * @param rhs the second histogram
+ * @return the number of common symbols
+*/
+std::size_t overlap(const std::array<std::size_t, 256>& lhs, const std::array<std::size_t, 256>& rhs);
+
+/**
+ * Scrambles the hashes in place with the MurmurHash3 finalizer.
+ * 
+ * @param hashes the hashes
+*/
+void mix(std::vector<std::uint64_t>& hashes);
+
+}  // namespace kernels
+
+#endif  // SRC_KERNELS_KERNELS_HPP_
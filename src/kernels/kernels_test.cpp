@@ -0,0 +1,191 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/kernels/kernels.hpp"
+
+namespace __kernels::test {
+
+constexpr std::array<kernels::Variant, 4> variants{
+    kernels::Variant::scalar,
+    kernels::Variant::sse42,
+    kernels::Variant::avx2,
+    kernels::Variant::avx512,
+};
+
+/* The lengths around the 64-symbol blocks, with a small alphabet to get long matches */
+std::vector<std::string> strings(void) {
+    std::mt19937 generator(42);
+
+    std::vector<std::string> strings;
+
+    for (std::size_t length : {0, 1, 7, 63, 64, 65, 127, 128, 129, 300, 1000}) {
+        for (std::size_t alphabet : {2, 4, 256}) {
+            std::string text(length, '\0');
+
+            for (auto& symbol : text) {
+                symbol = static_cast<char>(generator() % alphabet);
+            }
+
+            strings.push_back(std::move(text));
+        }
+    }
+
+    return strings;
+}
+
+/* The textbook matrix, one row at a time */
+std::size_t reference(std::string_view lhs, std::string_view rhs) {
+    std::vector<std::size_t> row(rhs.size() + 1);
+
+    for (std::size_t column = 0; column <= rhs.size(); ++column) {
+        row[column] = column;
+    }
+
+    for (std::size_t idx = 1; idx <= lhs.size(); ++idx) {
+        auto diagonal = row[0];
+        row[0] = idx;
+
+        for (std::size_t column = 1; column <= rhs.size(); ++column) {
+            auto substitution = diagonal + (lhs[idx - 1] != rhs[column - 1]);
+            diagonal = row[column];
+            row[column] = std::min({row[column] + 1, row[column - 1] + 1, substitution});
+        }
+    }
+
+    return row[rhs.size()];
+}
+
+/* Every result of the active variant, in a fixed order */
+std::vector<std::uint64_t> outcomes(const std::vector<std::string>& strings) {
+    std::vector<std::uint64_t> outcomes;
+
+    std::vector<std::string_view> candidates(strings.begin(), strings.end());
+
+    for (const auto& lhs : strings) {
+        for (const auto& rhs : strings) {
+            outcomes.push_back(kernels::levenshtein(lhs, rhs));
+            outcomes.push_back(kernels::levenshtein(lhs, rhs, 16));
+            outcomes.push_back(kernels::mismatches(lhs, rhs));
+        }
+
+        for (auto distance : kernels::levenshtein(lhs, candidates)) {
+            outcomes.push_back(distance);
+        }
+
+        for (const auto& rhs : strings) {
+            kernels::Grid grid(lhs, rhs, 1, 64);
+
+            /* The tiles are computed by anti-diagonals, as the parallel estimator does */
+            for (std::size_t diagonal = 0; diagonal + 1 < grid.rows() + grid.columns(); ++diagonal) {
+                for (std::size_t row = 0; row < grid.rows(); ++row) {
+                    if (row <= diagonal && diagonal - row < grid.columns()) {
+                        grid.compute(row, diagonal - row);
+                    }
+                }
+            }
+
+            outcomes.push_back(grid.distance());
+        }
+    }
+
+    for (std::size_t idx = 0; idx + 1 < strings.size(); ++idx) {
+        std::array<std::size_t, 256> lhs{};
+        std::array<std::size_t, 256> rhs{};
+
+        for (auto symbol : strings[idx]) {
+            lhs[static_cast<unsigned char>(symbol)] += 1;
+        }
+
+        for (auto symbol : strings[idx + 1]) {
+            rhs[static_cast<unsigned char>(symbol)] += 1;
+        }
+
+        outcomes.push_back(kernels::overlap(lhs, rhs));
+    }
+
+    std::vector<std::uint64_t> hashes;
+
+    for (std::uint64_t idx = 0; idx < 1000; ++idx) {
+        hashes.push_back(idx * 0x9E3779B97F4A7C15ULL);
+    }
+
+    kernels::mix(hashes);
+    outcomes.insert(outcomes.end(), hashes.begin(), hashes.end());
+
+    return outcomes;
+}
+
+}  // namespace __kernels::test
+
+int main() {
+    namespace test = __kernels::test;
+
+    try {
+        auto strings = test::strings();
+
+        kernels::select(kernels::Variant::scalar);
+
+        for (const auto& lhs : strings) {
+            for (const auto& rhs : strings) {
+                if (kernels::levenshtein(lhs, rhs) != test::reference(lhs, rhs)) {
+                    logging::error("The scalar kernel differs from the textbook distance");
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        auto expected = test::outcomes(strings);
+
+        for (auto variant : test::variants) {
+            if (!kernels::supported(variant)) {
+                continue;
+            }
+
+            kernels::select(variant);
+
+            if (test::outcomes(strings) != expected) {
+                auto detail = std::format("The kernel variant '{}' differs from the scalar one", kernels::name(variant));
+                logging::error(detail);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
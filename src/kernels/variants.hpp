@@ -0,0 +1,126 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_KERNELS_VARIANTS_HPP_
+#define SRC_KERNELS_VARIANTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Every variant is the same `body.inc` compiled with its own instruction set.
+
+namespace __kernels {
+
+/* The candidates of a batched call, eight 64-bit words fill a 512-bit register */
+constexpr std::size_t lanes = 8;
+
+}  // namespace __kernels
+
+namespace __kernels::scalar {
+
+std::int64_t tile(
+    const std::uint64_t* peq,
+    std::size_t blocks,
+    std::uint64_t* positive,
+    std::uint64_t* negative,
+    std::int8_t* carries,
+    std::string_view text,
+    std::size_t first,
+    std::size_t last,
+    std::size_t bit);
+
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs);
+void levenshtein(std::string_view query, const std::string_view* candidates, std::size_t count, std::size_t* distances);
+std::size_t bounded(std::string_view lhs, std::string_view rhs, std::size_t limit);
+std::size_t mismatches(const char* lhs, const char* rhs, std::size_t count);
+std::size_t overlap(const std::size_t* lhs, const std::size_t* rhs, std::size_t count);
+void mix(std::uint64_t* hashes, std::size_t count);
+
+}  // namespace __kernels::scalar
+
+namespace __kernels::sse42 {
+
+std::int64_t tile(
+    const std::uint64_t* peq,
+    std::size_t blocks,
+    std::uint64_t* positive,
+    std::uint64_t* negative,
+    std::int8_t* carries,
+    std::string_view text,
+    std::size_t first,
+    std::size_t last,
+    std::size_t bit);
+
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs);
+void levenshtein(std::string_view query, const std::string_view* candidates, std::size_t count, std::size_t* distances);
+std::size_t bounded(std::string_view lhs, std::string_view rhs, std::size_t limit);
+std::size_t mismatches(const char* lhs, const char* rhs, std::size_t count);
+std::size_t overlap(const std::size_t* lhs, const std::size_t* rhs, std::size_t count);
+void mix(std::uint64_t* hashes, std::size_t count);
+
+}  // namespace __kernels::sse42
+
+namespace __kernels::avx2 {
+
+std::int64_t tile(
+    const std::uint64_t* peq,
+    std::size_t blocks,
+    std::uint64_t* positive,
+    std::uint64_t* negative,
+    std::int8_t* carries,
+    std::string_view text,
+    std::size_t first,
+    std::size_t last,
+    std::size_t bit);
+
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs);
+void levenshtein(std::string_view query, const std::string_view* candidates, std::size_t count, std::size_t* distances);
+std::size_t bounded(std::string_view lhs, std::string_view rhs, std::size_t limit);
+std::size_t mismatches(const char* lhs, const char* rhs, std::size_t count);
+std::size_t overlap(const std::size_t* lhs, const std::size_t* rhs, std::size_t count);
+void mix(std::uint64_t* hashes, std::size_t count);
+
+}  // namespace __kernels::avx2
+
+namespace __kernels::avx512 {
+
+std::int64_t tile(
+    const std::uint64_t* peq,
+    std::size_t blocks,
+    std::uint64_t* positive,
+    std::uint64_t* negative,
+    std::int8_t* carries,
+    std::string_view text,
+    std::size_t first,
+    std::size_t last,
+    std::size_t bit);
+
+std::size_t levenshtein(std::string_view lhs, std::string_view rhs);
+void levenshtein(std::string_view query, const std::string_view* candidates, std::size_t count, std::size_t* distances);
+std::size_t bounded(std::string_view lhs, std::string_view rhs, std::size_t limit);
+std::size_t mismatches(const char* lhs, const char* rhs, std::size_t count);
+std::size_t overlap(const std::size_t* lhs, const std::size_t* rhs, std::size_t count);
+void mix(std::uint64_t* hashes, std::size_t count);
+
+}  // namespace __kernels::avx512
+
+#endif  // SRC_KERNELS_VARIANTS_HPP_
@@ -21,100 +21,537 @@
 
 #include "src/kvcache/kvcache.hpp"
 
-#include <cassert>
-#include <chrono>
-#include <exception>
+#include <cstdlib>
+#include <cstring>
 #include <format>
-#include <fstream>
-#include <functional>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
-#include <experimental/embed>
+#include "lib/diskio/diskio.hpp"
 
-#include <rapidjson/document.h>
+namespace __kvcache::record {
 
-#include "src/errors/filesystem/filesystem.hpp"
+/* The log is written in the native byte order */
+constexpr std::uint32_t magic = 0x314B5647;  // "GVK1"
 
-#include "src/ext/rapidjson/build/build.hpp"
-#include "src/ext/rapidjson/filesystem/filesystem.hpp"
-#include "src/ext/rapidjson/schema/schema.hpp"
+constexpr std::uint8_t put = 1;
+constexpr std::uint8_t drop = 2;
 
-namespace __kvcache {
+constexpr std::size_t header = sizeof(std::uint32_t)
+                             + sizeof(std::uint8_t)
+                             + sizeof(std::int64_t)
+                             + sizeof(std::uint32_t)
+                             + sizeof(std::uint32_t);
 
-constexpr auto schema = std::embed("src/kvcache/protocol.json");
+constexpr std::size_t trailer = sizeof(std::uint32_t);
 
-std::filesystem::path path_to(const std::string& key) {
-    auto hash = std::to_string(std::hash<std::string>{}(key));
-    return std::filesystem::temp_directory_path() / hash;
+std::uint32_t checksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261U;
+
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        hash ^= static_cast<unsigned char>(data[idx]);
+        hash *= 16777619U;
+    }
+
+    return hash;
 }
 
-}  // namespace __kvcache
+template<typename Integer>
+void pack(std::string& buffer, Integer value) {
+    char bytes[sizeof(Integer)];
+    std::memcpy(bytes, &value, sizeof(Integer));
+    buffer.append(bytes, sizeof(Integer));
+}
 
-bool kvcache::exists(const std::string& key) {
-    auto path = __kvcache::path_to(key);
+template<typename Integer>
+Integer unpack(const char* data) {
+    Integer value;
+    std::memcpy(&value, data, sizeof(Integer));
+    return value;
+}
 
-    try {
-        auto document = rapidjson::filesystem::read(path);
-        if (!rapidjson::schema::ok(document, __kvcache::schema)) {
-            return false;
-        }
-        if (document["key"].GetString() != key) {
-            return false;
+std::string serialize(
+    std::uint8_t operation,
+    std::time_t timestamp,
+    const std::string& key,
+    const std::string& value
+) {
+    std::string buffer;
+    buffer.reserve(header + key.size() + value.size() + trailer);
+
+    pack<std::uint32_t>(buffer, magic);
+    pack<std::uint8_t>(buffer, operation);
+    pack<std::int64_t>(buffer, timestamp);
+    pack<std::uint32_t>(buffer, key.size());
+    pack<std::uint32_t>(buffer, value.size());
+
+    buffer += key;
+    buffer += value;
+
+    pack<std::uint32_t>(buffer, checksum(buffer.data(), buffer.size()));
+
+    return buffer;
+}
+
+}  // namespace __kvcache::record
+
+namespace __kvcache::compaction {
+
+/* Compaction is not worth it for small logs */
+constexpr std::size_t threshold = 1024;
+
+}  // namespace __kvcache::compaction
+
+namespace __kvcache::generation {
+
+/* The lock file keeps the number of compactions, so that the processes notice a new log */
+std::uint64_t read(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+
+    std::uint64_t generation = 0;
+    stream.read(reinterpret_cast<char*>(&generation), sizeof(generation));
+
+    return stream ? generation : 0;
+}
+
+void write(const std::filesystem::path& path, std::uint64_t generation) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(&generation), sizeof(generation));
+    stream.close();
+
+    if (!stream) {
+        auto detail = std::format("Failed to write the file {}", path.string());
+        throw std::runtime_error(detail);
+    }
+}
+
+}  // namespace __kvcache::generation
+
+namespace __kvcache::registry {
+
+static std::mutex mutex;
+
+static std::filesystem::path directory;
+
+static std::unordered_map<std::string, std::unique_ptr<kvcache::Store>> stores;
+
+}  // namespace __kvcache::registry
+
+namespace kvcache {
+
+Store::Store(const std::filesystem::path& path) : path_(path), lock_(path) {
+    this->lock_ += ".lock";
+
+    if (std::filesystem::exists(path) && !std::filesystem::is_regular_file(path)) {
+        auto detail = std::format("The path {} is not a regular file", path.string());
+        throw std::runtime_error(detail);
+    }
+
+    diskio::Lock interprocess(this->lock_);
+
+    this->refresh_();
+
+    if (this->garbage_ >= __kvcache::compaction::threshold
+        && this->garbage_ > this->index_.size()) {
+        this->compact_();
+    }
+}
+
+bool Store::exists(const std::string& key) const {
+    std::shared_lock lock(this->smutex_);
+    return this->index_.contains(key);
+}
+
+Cache Store::read(const std::string& key) const {
+    Cache object;
+
+    {
+        std::shared_lock lock(this->smutex_);
+
+        if (this->fetch_(key, object)) {
+            return object;
         }
     }
-    catch (const std::exception&) {
+
+    /* The record may have been moved or dropped by another process */
+    std::unique_lock lock(this->smutex_);
+
+    {
+        diskio::Lock interprocess(this->lock_);
+        this->refresh_();
+    }
+
+    if (!this->fetch_(key, object)) {
+        auto detail = std::format("The cache is missing for key {}", key);
+        throw std::runtime_error(detail);
+    }
+
+    return object;
+}
+
+void Store::write(const std::string& key, const std::string& value) {
+    std::unique_lock lock(this->smutex_);
+    diskio::Lock interprocess(this->lock_);
+
+    this->refresh_();
+    this->append_(__kvcache::record::put, key, value);
+}
+
+void Store::transact(const std::function<void(std::size_t, const Writer&)>& transaction) {
+    std::unique_lock lock(this->smutex_);
+    diskio::Lock interprocess(this->lock_);
+
+    this->refresh_();
+
+    auto write = [this](const std::string& key, const std::string& value) {
+        this->append_(__kvcache::record::put, key, value);
+    };
+
+    transaction(this->index_.size(), write);
+}
+
+void Store::drop(const std::string& key) {
+    std::unique_lock lock(this->smutex_);
+    diskio::Lock interprocess(this->lock_);
+
+    this->refresh_();
+
+    if (!this->index_.contains(key)) {
+        return;
+    }
+
+    this->append_(__kvcache::record::drop, key, "");
+}
+
+void Store::compact(void) {
+    std::unique_lock lock(this->smutex_);
+    diskio::Lock interprocess(this->lock_);
+
+    this->refresh_();
+    this->compact_();
+}
+
+std::size_t Store::size(void) const {
+    std::shared_lock lock(this->smutex_);
+    return this->index_.size();
+}
+
+/* Reads the whole record, a stale offset never yields the bytes of another one */
+bool Store::fetch_(const std::string& key, Cache& object) const {
+    auto iterator = this->index_.find(key);
+    if (iterator == this->index_.end()) {
+        return false;
+    }
+
+    const auto& entry = iterator->second;
+
+    std::ifstream stream(this->path_, std::ios::binary);
+    if (!stream.is_open()) {
+        return false;
+    }
+
+    auto size = __kvcache::record::header + key.size() + entry.length;
+
+    std::string buffer(size + __kvcache::record::trailer, '\0');
+
+    stream.seekg(entry.offset - __kvcache::record::header - key.size());
+    if (!stream.read(buffer.data(), buffer.size())) {
+        return false;
+    }
+
+    const auto* data = buffer.data();
+
+    auto magic = __kvcache::record::unpack<std::uint32_t>(data);
+    auto operation = __kvcache::record::unpack<std::uint8_t>(data + sizeof(std::uint32_t));
+    auto expected = __kvcache::record::unpack<std::uint32_t>(data + size);
+
+    auto matches = magic == __kvcache::record::magic
+        && operation == __kvcache::record::put
+        && std::string_view(data + __kvcache::record::header, key.size()) == key
+        && __kvcache::record::checksum(data, size) == expected;
+
+    if (!matches) {
         return false;
     }
 
+    object.key = key;
+    object.value.assign(data + __kvcache::record::header + key.size(), entry.length);
+    object.timestamp = entry.timestamp;
+
     return true;
 }
 
-kvcache::Cache kvcache::read(const std::string& key) {
-    if (!kvcache::exists(key)) {
-        auto detail = std::format("The cache is missing for key {}", key);
+/* Must hold the lock of the log */
+void Store::refresh_(void) const {
+    auto generation = __kvcache::generation::read(this->lock_);
+
+    auto exists = std::filesystem::exists(this->path_);
+    auto size = exists ? std::filesystem::file_size(this->path_) : 0;
+
+    /* The log was compacted or removed by another process, it is replayed from scratch */
+    if (!this->log_.is_open() || !exists || generation != this->generation_ || size < this->tail_) {
+        this->index_.clear();
+        this->tail_ = 0;
+        this->garbage_ = 0;
+        this->generation_ = generation;
+
+        this->replay_(0);
+
+        this->log_.close();
+        this->log_.clear();
+        this->log_.open(this->path_, std::ios::binary | std::ios::app);
+
+        if (!this->log_.is_open()) {
+            auto detail = std::format("Failed to open the file {}", this->path_.string());
+            throw std::runtime_error(detail);
+        }
+
+        return;
+    }
+
+    /* The records appended by other processes */
+    if (size > this->tail_) {
+        this->replay_(this->tail_);
+    }
+}
+
+void Store::replay_(std::uint64_t start) const {
+    if (!std::filesystem::exists(this->path_)) {
+        return;
+    }
+
+    std::ifstream stream(this->path_, std::ios::binary);
+    if (!stream.is_open()) {
+        auto detail = std::format("Failed to open the file {}", this->path_.string());
         throw std::runtime_error(detail);
     }
 
-    auto path = __kvcache::path_to(key);
-    auto document = rapidjson::filesystem::read(path);
+    stream.seekg(start);
 
-    kvcache::Cache object;
-    object.key = key;
+    std::uint64_t good = start;
+    std::string buffer;
+
+    while (true) {
+        buffer.resize(__kvcache::record::header);
+        if (!stream.read(buffer.data(), buffer.size())) {
+            break;
+        }
 
-    object.value = document["value"].GetString();
-    object.timestamp = document["timestamp"].GetInt64();
+        const auto* data = buffer.data();
 
-    return object;
+        auto magic = __kvcache::record::unpack<std::uint32_t>(data);
+        data += sizeof(std::uint32_t);
+
+        if (magic != __kvcache::record::magic) {
+            break;
+        }
+
+        auto operation = __kvcache::record::unpack<std::uint8_t>(data);
+        data += sizeof(std::uint8_t);
+
+        auto timestamp = __kvcache::record::unpack<std::int64_t>(data);
+        data += sizeof(std::int64_t);
+
+        auto klength = __kvcache::record::unpack<std::uint32_t>(data);
+        data += sizeof(std::uint32_t);
+
+        auto vlength = __kvcache::record::unpack<std::uint32_t>(data);
+
+        auto payload = static_cast<std::size_t>(klength) + vlength;
+
+        buffer.resize(__kvcache::record::header + payload + __kvcache::record::trailer);
+        if (!stream.read(buffer.data() + __kvcache::record::header, payload + __kvcache::record::trailer)) {
+            break;
+        }
+
+        auto size = __kvcache::record::header + payload;
+
+        auto expected = __kvcache::record::unpack<std::uint32_t>(buffer.data() + size);
+        if (__kvcache::record::checksum(buffer.data(), size) != expected) {
+            break;
+        }
+
+        std::string key(buffer.data() + __kvcache::record::header, klength);
+
+        if (this->index_.contains(key)) {
+            this->garbage_ += 1;
+        }
+
+        if (operation == __kvcache::record::put) {
+            auto offset = good + __kvcache::record::header + klength;
+            this->index_[key] = Entry{offset, vlength, static_cast<std::time_t>(timestamp)};
+
+        } else if (operation == __kvcache::record::drop) {
+            this->index_.erase(key);
+            this->garbage_ += 1;
+
+        } else {
+            break;
+        }
+
+        good += buffer.size();
+    }
+
+    stream.close();
+
+    /* Discard the torn tail left by an interrupted write */
+    if (std::filesystem::file_size(this->path_) != good) {
+        std::filesystem::resize_file(this->path_, good);
+    }
+
+    this->tail_ = good;
 }
 
-void kvcache::write(const std::string& key, const std::string& value) {
+void Store::append_(std::uint8_t operation, const std::string& key, const std::string& value) {
     auto now = std::chrono::system_clock::now();
     auto timestamp = std::chrono::system_clock::to_time_t(now);
 
-    rapidjson::Document document;
-    document.SetObject();
+    auto record = __kvcache::record::serialize(operation, timestamp, key, value);
 
-    auto& allocator = document.GetAllocator();
+    /* A single write per record keeps concurrent appenders from interleaving */
+    this->log_.write(record.data(), record.size());
+    this->log_.flush();
 
-    document.AddMember("key", rapidjson::build::string(key, allocator), allocator);
-    document.AddMember("value", rapidjson::build::string(value, allocator), allocator);
-    document.AddMember("timestamp", rapidjson::Value(timestamp), allocator);
+    if (!this->log_) {
+        this->log_.clear();
 
-    assert(rapidjson::schema::ok(document, __kvcache::schema));
+        auto detail = std::format("Failed to write the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
 
-    auto path = __kvcache::path_to(key);
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path)) {
-        return;
+    if (this->index_.contains(key)) {
+        this->garbage_ += 1;
     }
 
-    try {
-        rapidjson::filesystem::write(document, path);
+    if (operation == __kvcache::record::put) {
+        auto offset = this->tail_ + __kvcache::record::header + key.size();
+        this->index_[key] = Entry{offset, static_cast<std::uint32_t>(value.size()), timestamp};
+    } else {
+        this->index_.erase(key);
+        this->garbage_ += 1;
     }
-    catch (const std::exception&) {}
+
+    this->tail_ += record.size();
 }
 
-void kvcache::drop(const std::string& key) {
-    auto path = __kvcache::path_to(key);
-    std::filesystem::remove(path);
+void Store::compact_(void) {
+    auto temporary = this->path_;
+    temporary += ".compact";
+
+    std::ifstream source(this->path_, std::ios::binary);
+    std::ofstream destination(temporary, std::ios::binary | std::ios::trunc);
+
+    if (!source.is_open() || !destination.is_open()) {
+        auto detail = std::format("Failed to compact the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+
+    std::unordered_map<std::string, Entry> index;
+    std::uint64_t tail = 0;
+
+    std::string value;
+
+    for (const auto& [key, entry] : this->index_) {
+        value.resize(entry.length);
+
+        source.seekg(entry.offset);
+        source.read(value.data(), entry.length);
+
+        auto record = __kvcache::record::serialize(
+            __kvcache::record::put,
+            entry.timestamp,
+            key,
+            value);
+
+        destination.write(record.data(), record.size());
+
+        auto offset = tail + __kvcache::record::header + key.size();
+        index[key] = Entry{offset, entry.length, entry.timestamp};
+
+        tail += record.size();
+    }
+
+    destination.flush();
+
+    if (!source || !destination) {
+        destination.close();
+        std::filesystem::remove(temporary);
+
+        auto detail = std::format("Failed to compact the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+
+    source.close();
+    destination.close();
+
+    /* A crash never replaces the log by an unwritten one */
+    diskio::sync(temporary);
+
+    /* Bumped first, a crash right after it only costs the others a full replay */
+    __kvcache::generation::write(this->lock_, this->generation_ + 1);
+
+    this->log_.close();
+
+    /* Readers observe either the old or the new log, never a partial one */
+    std::filesystem::rename(temporary, this->path_);
+    diskio::sync(std::filesystem::absolute(this->path_).parent_path());
+
+    this->log_.clear();
+    this->log_.open(this->path_, std::ios::binary | std::ios::app);
+
+    if (!this->log_.is_open()) {
+        auto detail = std::format("Failed to open the file {}", this->path_.string());
+        throw std::runtime_error(detail);
+    }
+
+    this->index_ = std::move(index);
+    this->tail_ = tail;
+    this->garbage_ = 0;
+    this->generation_ += 1;
+}
+
+
+}  // namespace kvcache
+
+void kvcache::configure(const std::filesystem::path& directory) {
+    std::lock_guard lock(__kvcache::registry::mutex);
+
+    if (!__kvcache::registry::stores.empty()) {
+        constexpr auto detail = "The cache directory must be configured before opening stores";
+        throw std::runtime_error(detail);
+    }
+
+    __kvcache::registry::directory = directory;
+}
+
+std::filesystem::path kvcache::directory(void) {
+    std::lock_guard lock(__kvcache::registry::mutex);
+
+    if (!__kvcache::registry::directory.empty()) {
+        return __kvcache::registry::directory;
+    }
+
+    if (auto variable = std::getenv("GELADA_CACHE_DIR"); variable && *variable) {
+        return variable;
+    }
+
+    return std::filesystem::temp_directory_path() / "gelada";
+}
+
+kvcache::Store& kvcache::open(const std::string& name) {
+    auto root = kvcache::directory();
+
+    std::lock_guard lock(__kvcache::registry::mutex);
+
+    auto& store = __kvcache::registry::stores[name];
+
+    if (!store) {
+        std::filesystem::create_directories(root);
+        store = std::make_unique<kvcache::Store>(root / std::format("{}.log", name));
+    }
+
+    return *store;
 }
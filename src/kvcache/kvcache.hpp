@@ -23,7 +23,15 @@
 #define SRC_KVCACHE_KVCACHE_HPP_
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 namespace kvcache {
 
@@ -41,35 +49,147 @@ struct Cache {
 };
 
 /**
- * Checks if there is a cache with such a key.
+ * Saves the value with the specified key within a transaction.
  * 
  * @param key <no specification required>
- * @return if there is a cached object with this key
+ * @param value <no specification required>
 */
-bool exists(const std::string& key);
+using Writer = std::function<void(const std::string& key, const std::string& value)>;
 
 /**
- * Reads the cache by the specified key.
+ * Key-value store backed by a single append-only log file.
  * 
- * @param key <no specification required>
- * @return the cached object
+ * @note thread-safe
+ * @note readers do not block each other
+ * @note a torn or corrupted tail of the log is discarded on opening
+ * @note the log may be shared by processes: every modification holds the advisory lock of
+ *       `<log>.lock` and first replays the records appended by the others
+ * @note the compacted log reaches the disk before it replaces the old one
 */
-Cache read(const std::string& key);
+class Store {
+ public:
+    /**
+     * Opens the store, replaying the log to rebuild the in-memory index.
+     * 
+     * @param path the path to the log file
+     * 
+     * @note the log is created if it does not exist
+    */
+    explicit Store(const std::filesystem::path& path);
+
+    /**
+     * Checks if there is a cache with such a key.
+     * 
+     * @param key <no specification required>
+     * @return if there is a cached object with this key
+    */
+    bool exists(const std::string& key) const;
+
+    /**
+     * Reads the cache by the specified key.
+     * 
+     * @param key <no specification required>
+     * @return the cached object
+    */
+    Cache read(const std::string& key) const;
+
+    /**
+     * Saves the value with the specified key.
+     * 
+     * @param key <no specification required>
+     * @param value <no specification required>
+     * 
+     * @note the record is flushed before it becomes visible to readers
+    */
+    void write(const std::string& key, const std::string& value);
+
+    /**
+     * Runs the transaction holding the lock of the log, no process modifies the store meanwhile.
+     * 
+     * @param transaction receives the number of keys, up to date with the other processes,
+     *                    and the function saving a record
+     * 
+     * @note the transaction must not call the other methods of the store
+    */
+    void transact(const std::function<void(std::size_t, const Writer&)>& transaction);
+
+    /**
+     * Drops the object with the specified key.
+     * 
+     * @param key <no specification required>
+    */
+    void drop(const std::string& key);
+
+    /**
+     * Rewrites the log so that it contains only the live records.
+     * 
+     * @note the log is replaced atomically
+     * @note the other processes replay the new log on their next access
+    */
+    void compact(void);
+
+    /**
+     * Counts the live records of the store.
+     * 
+     * @return the number of keys
+    */
+    std::size_t size(void) const;
+
+ private:
+    struct Entry {
+        std::uint64_t offset;
+        std::uint32_t length;
+        std::time_t timestamp;
+    };
+
+    bool fetch_(const std::string& key, Cache& object) const;
+    void refresh_(void) const;
+    void replay_(std::uint64_t start) const;
+    void append_(std::uint8_t operation, const std::string& key, const std::string& value);
+    void compact_(void);
+
+    mutable std::shared_mutex smutex_{};
+
+    std::filesystem::path path_;
+    std::filesystem::path lock_;
+
+    /* The view of the log is refreshed by the readers as well */
+    mutable std::ofstream log_;
+
+    mutable std::unordered_map<std::string, Entry> index_;
+
+    mutable std::uint64_t tail_ = 0;
+    mutable std::uint64_t generation_ = 0;
+    mutable std::size_t garbage_ = 0;
+};
 
 /**
- * Saves the value with the specified key.
+ * Sets the directory in which the stores are kept.
  * 
- * @param key <no specification required>
- * @param value <no specification required>
+ * @param directory the path to the cache directory
+ * 
+ * @note must be called before the first `open`
 */
-void write(const std::string& key, const std::string& value);
+void configure(const std::filesystem::path& directory);
 
 /**
- * Drops the object with the specified key.
+ * Gets the directory in which the stores are kept.
  * 
- * @param key <no specification required>
+ * @return the path to the cache directory
+ * 
+ * @note defaults to `$GELADA_CACHE_DIR` or to the `gelada` subdirectory of the temporary directory
+*/
+std::filesystem::path directory(void);
+
+/**
+ * Opens the named store located in the cache directory.
+ * 
+ * @param name the name of the store
+ * @return the store shared by all callers
+ * 
+ * @note thread-safe
 */
-void drop(const std::string& key);
+Store& open(const std::string& name);
 
 }  // namespace kvcache
 
@@ -0,0 +1,136 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/kvcache/kvcache.hpp"
+
+namespace __kvcache::test {
+
+const auto directory = std::filesystem::temp_directory_path() / "gelada-kvcache-test";
+const auto log = directory / "store.log";
+
+/* The keys `0..count` hold their own names repeated */
+bool holds(const kvcache::Store& store, std::size_t count) {
+    if (store.size() != count) {
+        return false;
+    }
+
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        auto key = std::to_string(idx);
+
+        if (!store.exists(key) || store.read(key).value != key + key) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* An interrupted write leaves a partial record, which is cut off on opening */
+bool torn(void) {
+    {
+        kvcache::Store store(log);
+
+        for (std::size_t idx = 0; idx < 3; ++idx) {
+            auto key = std::to_string(idx);
+            store.write(key, key + key);
+        }
+    }
+
+    auto size = std::filesystem::file_size(log);
+
+    /* The last record loses its checksum */
+    std::filesystem::resize_file(log, size - 2);
+
+    {
+        kvcache::Store store(log);
+
+        if (!holds(store, 2) || std::filesystem::file_size(log) >= size - 2) {
+            return false;
+        }
+
+        store.write("2", "22");
+    }
+
+    kvcache::Store store(log);
+    return holds(store, 3) && std::filesystem::file_size(log) == size;
+}
+
+/* The compacted log keeps only the live records */
+bool compacted(void) {
+    kvcache::Store store(log);
+
+    for (std::size_t round = 0; round < 8; ++round) {
+        for (std::size_t idx = 0; idx < 3; ++idx) {
+            auto key = std::to_string(idx);
+            store.write(key, key + key);
+        }
+    }
+
+    store.write("3", "33");
+    store.drop("3");
+
+    auto size = std::filesystem::file_size(log);
+
+    store.compact();
+
+    if (!holds(store, 3) || std::filesystem::file_size(log) >= size) {
+        return false;
+    }
+
+    kvcache::Store reopened(log);
+    return holds(reopened, 3);
+}
+
+}  // namespace __kvcache::test
+
+int main() {
+    namespace test = __kvcache::test;
+
+    try {
+        std::filesystem::remove_all(test::directory);
+        std::filesystem::create_directories(test::directory);
+
+        if (!test::torn()) {
+            logging::error("The torn tail of the log was not discarded");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::compacted()) {
+            logging::error("The compaction lost or kept the wrong records");
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove_all(test::directory);
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
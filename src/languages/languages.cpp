@@ -0,0 +1,179 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/languages/languages.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <string_view>
+
+#include "src/ast/anylang/anylang.hpp"
+
+namespace __languages::names {
+
+struct Entry {
+    std::string_view suffix;
+    std::string_view language;
+};
+
+/* Both extensions and whole file names */
+constexpr Entry table[] = {
+    {".bash", "shell"},
+    {".bazel", "starlark"},
+    {".bzl", "starlark"},
+    {".c", "c"},
+    {".c++", "cpp"},
+    {".cc", "cpp"},
+    {".cjs", "javascript"},
+    {".cpp", "cpp"},
+    {".cs", "csharp"},
+    {".css", "css"},
+    {".csv", "data"},
+    {".cts", "typescript"},
+    {".cxx", "cpp"},
+    {".go", "go"},
+    {".h", "c"},
+    {".h++", "cpp"},
+    {".hh", "cpp"},
+    {".hpp", "cpp"},
+    {".hs", "haskell"},
+    {".htm", "html"},
+    {".html", "html"},
+    {".hxx", "cpp"},
+    {".ini", "data"},
+    {".ipp", "cpp"},
+    {".java", "java"},
+    {".js", "javascript"},
+    {".json", "data"},
+    {".jsx", "javascript"},
+    {".kt", "kotlin"},
+    {".kts", "kotlin"},
+    {".md", "text"},
+    {".mjs", "javascript"},
+    {".mts", "typescript"},
+    {".php", "php"},
+    {".py", "python"},
+    {".pyi", "python"},
+    {".pyw", "python"},
+    {".rb", "ruby"},
+    {".rs", "rust"},
+    {".rst", "text"},
+    {".scala", "scala"},
+    {".sh", "shell"},
+    {".sql", "sql"},
+    {".star", "starlark"},
+    {".swift", "swift"},
+    {".toml", "data"},
+    {".ts", "typescript"},
+    {".tsx", "typescript"},
+    {".txt", "text"},
+    {".xml", "data"},
+    {".yaml", "data"},
+    {".yml", "data"},
+    {".zsh", "shell"},
+    {"BUILD", "starlark"},
+    {"WORKSPACE", "starlark"},
+};
+
+/* Languages that are often translated into each other */
+const std::vector<std::vector<std::string>> kinship = {
+    {"c", "cpp"},
+    {"javascript", "typescript"},
+    {"python", "starlark"},
+};
+
+std::string lookup(std::string_view key) {
+    for (const auto& entry : table) {
+        if (entry.suffix == key) {
+            return std::string(entry.language);
+        }
+    }
+
+    return "";
+}
+
+}  // namespace __languages::names
+
+std::string languages::detect(const std::filesystem::path& path) {
+    auto extension = path.extension().string();
+
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char symbol) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(symbol)));
+    });
+
+    auto language = __languages::names::lookup(path.filename().string());
+
+    if (language.empty() && !extension.empty()) {
+        language = __languages::names::lookup(extension);
+    }
+
+    if (!language.empty() || !std::filesystem::is_regular_file(path)) {
+        return language;
+    }
+
+    /* Scripts without an extension are common */
+    try {
+        return ast::anylang::language(path);
+    }
+    catch (const std::exception&) {
+        return "";
+    }
+}
+
+languages::Table::Table() {
+    for (const auto& languages : __languages::names::kinship) {
+        this->join(languages);
+    }
+}
+
+void languages::Table::join(const std::vector<std::string>& languages) {
+    if (languages.empty()) {
+        return;
+    }
+
+    auto root = this->root_(languages.front());
+
+    for (const auto& language : languages) {
+        this->parents_[this->root_(language)] = root;
+    }
+
+    this->parents_[root] = root;
+}
+
+bool languages::Table::compatible(const std::string& lhs, const std::string& rhs) const {
+    if (lhs.empty() || rhs.empty()) {
+        return true;
+    }
+
+    return this->root_(lhs) == this->root_(rhs);
+}
+
+std::string languages::Table::root_(const std::string& language) const {
+    auto current = language;
+
+    for (auto it = this->parents_.find(current); it != this->parents_.end() && it->second != current;) {
+        current = it->second;
+        it = this->parents_.find(current);
+    }
+
+    return current;
+}
@@ -0,0 +1,83 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_LANGUAGES_LANGUAGES_HPP_
+#define SRC_LANGUAGES_LANGUAGES_HPP_
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace languages {
+
+/**
+ * Detects the language of the file.
+ * 
+ * @param path the path to the file
+ * @return the language, e.g. `python`, or an empty string if unknown
+ * 
+ * @note the name of the file is checked first
+ * @note otherwise, an existing file is inspected by its abstract syntax tree
+ * @note uses the `Python` interpreter for the files of unknown names
+*/
+std::string detect(const std::filesystem::path& path);
+
+/**
+ * Table of the languages whose files may be copied from each other.
+ * 
+ * @note every language is compatible with itself
+ * @note unknown languages are compatible with every language
+*/
+class Table {
+ public:
+    /**
+     * Creates the table with the default compatibilities, e.g. `c` and `cpp`.
+    */
+    Table();
+
+    /**
+     * Makes the languages compatible with each other.
+     * 
+     * @param languages the languages to be joined
+     * 
+     * @note compatibility is transitive
+    */
+    void join(const std::vector<std::string>& languages);
+
+    /**
+     * Checks whether the files of the languages may be compared.
+     * 
+     * @param lhs the language of the file
+     * @param rhs the language of the file
+     * @return if the languages are compatible
+    */
+    bool compatible(const std::string& lhs, const std::string& rhs) const;
+
+ private:
+    std::string root_(const std::string& language) const;
+
+    std::unordered_map<std::string, std::string> parents_;
+};
+
+}  // namespace languages
+
+#endif  // SRC_LANGUAGES_LANGUAGES_HPP_
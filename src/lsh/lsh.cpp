@@ -0,0 +1,125 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/lsh/lsh.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace __lsh {
+
+constexpr std::uint64_t mix(std::uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}  // namespace __lsh
+
+std::vector<std::uint64_t> lsh::signature(
+    const std::vector<std::uint64_t>& shingles,
+    std::size_t size
+) {
+    std::vector<std::uint64_t> minima(size, std::numeric_limits<std::uint64_t>::max());
+
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        auto seed = __lsh::mix(idx + 1);
+
+        for (auto shingle : shingles) {
+            minima[idx] = std::min(minima[idx], __lsh::mix(shingle ^ seed));
+        }
+    }
+
+    return minima;
+}
+
+namespace lsh {
+
+Index::Index(std::size_t bands, std::size_t rows) : bands_(bands), rows_(rows) {
+    if (bands == 0) {
+        constexpr auto detail = "The number of bands must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    if (rows == 0) {
+        constexpr auto detail = "The number of rows must be positive";
+        throw std::runtime_error(detail);
+    }
+
+    this->postings_.resize(bands);
+}
+
+void Index::add(const std::string& key, const std::vector<std::uint64_t>& shingles) {
+    if (shingles.empty()) {
+        return;
+    }
+
+    auto minima = lsh::signature(shingles, this->bands_ * this->rows_);
+
+    std::vector<std::uint64_t> buckets(this->bands_);
+
+    for (std::size_t band = 0; band < this->bands_; ++band) {
+        std::uint64_t bucket = __lsh::mix(band);
+
+        for (std::size_t row = 0; row < this->rows_; ++row) {
+            bucket = __lsh::mix(bucket ^ minima[band * this->rows_ + row]);
+        }
+
+        buckets[band] = bucket;
+    }
+
+    std::lock_guard lock(this->mutex_);
+
+    /* Identical sets share the key, a second posting would pair the key with itself */
+    if (!this->keys_.insert(key).second) {
+        return;
+    }
+
+    for (std::size_t band = 0; band < this->bands_; ++band) {
+        this->postings_[band][buckets[band]].push_back(key);
+    }
+}
+
+std::vector<std::pair<std::string, std::string>> Index::candidates(void) const {
+    std::vector<std::pair<std::string, std::string>> pairs;
+
+    for (const auto& postings : this->postings_) {
+        for (const auto& [bucket, keys] : postings) {
+            for (std::size_t lidx = 0; lidx < keys.size(); ++lidx) {
+                for (std::size_t ridx = lidx + 1; ridx < keys.size(); ++ridx) {
+                    pairs.push_back(std::minmax(keys[lidx], keys[ridx]));
+                }
+            }
+        }
+    }
+
+    /* A pair sharing several bands is listed once */
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    return pairs;
+}
+
+}  // namespace lsh
@@ -0,0 +1,97 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_LSH_LSH_HPP_
+#define SRC_LSH_LSH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lsh {
+
+/**
+ * Computes the `MinHash` signature of the set.
+ * 
+ * @param shingles the elements of the set
+ * @param size the number of hash functions
+ * @return the minimum of every hash function over the set
+ * 
+ * @note the fraction of equal positions estimates the Jaccard similarity
+*/
+std::vector<std::uint64_t> signature(const std::vector<std::uint64_t>& shingles, std::size_t size);
+
+/**
+ * Locality-sensitive hashing index over the `MinHash` signatures.
+ * 
+ * @note two sets collide if all rows of at least one band are equal
+ * @note every band keeps the postings of its buckets, the candidate pairs are read from them
+ * @note with Jaccard similarity `J`, the probability of a collision is `1 - (1 - J^rows)^bands`
+*/
+class Index {
+ public:
+    /**
+     * Creates an empty index.
+     * 
+     * @param bands the number of bands
+     * @param rows the number of signature positions per band
+    */
+    Index(std::size_t bands, std::size_t rows);
+
+    /**
+     * Adds the set to the index.
+     * 
+     * @param key the identifier of the set
+     * @param shingles the elements of the set
+     * 
+     * @note thread-safe, but must not be called concurrently with `candidates`
+     * @note a key is indexed once, the repeated additions are ignored
+    */
+    void add(const std::string& key, const std::vector<std::uint64_t>& shingles);
+
+    /**
+     * Enumerates the pairs of sets sharing a bucket in at least one band.
+     * 
+     * @return the pairs of identifiers, each pair once and the lesser identifier first
+     * 
+     * @note the cost depends on the sizes of the buckets, not on the number of all pairs
+     * @note empty sets are not indexed, they are never enumerated
+    */
+    std::vector<std::pair<std::string, std::string>> candidates(void) const;
+
+ private:
+    std::size_t bands_;
+    std::size_t rows_;
+
+    std::mutex mutex_{};
+
+    std::unordered_set<std::string> keys_;
+    std::vector<std::unordered_map<std::uint64_t, std::vector<std::string>>> postings_;
+};
+
+}  // namespace lsh
+
+#endif  // SRC_LSH_LSH_HPP_
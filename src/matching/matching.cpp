@@ -0,0 +1,103 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/matching/matching.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "lib/itertools/itertools.hpp"
+#include "lib/math/math.hpp"
+
+matching::Matching matching::best(
+    const std::vector<double>& scores,
+    std::size_t dof,
+    double threshold
+) {
+    matching::Matching result{0.0, {}};
+
+    /* There may be fewer files than the user-specified DOF */
+    auto matching_size = std::min<std::size_t>(dof, scores.size());
+
+    std::vector<std::size_t> candidates;
+    std::vector<double> probabilities;
+
+    for (std::size_t size = 1; size <= matching_size; ++size) {
+        auto combinations = itertools::combinations(scores.size(), size);
+
+        for (const auto& indices : combinations) {
+            bool skip = false;
+
+            candidates.clear();
+            probabilities.clear();
+
+            for (const auto& idx : indices) {
+                auto prob = scores[idx];
+
+                if (prob < threshold) {
+                    skip = true;
+                    break;
+                }
+
+                candidates.push_back(idx);
+                probabilities.push_back(prob);
+            }
+
+            if (skip) {
+                continue;
+            }
+
+            auto probability = math::probability::gmean(probabilities);
+            if (probability > result.confidence) {
+                result.sources = candidates;
+                result.confidence = probability;
+            }
+        }
+    }
+
+    return result;
+}
+
+matching::Matching matching::best(
+    std::span<const matrices::Entry> row,
+    std::size_t dof,
+    double threshold
+) {
+    std::vector<double> scores;
+    std::vector<std::uint32_t> columns;
+
+    /* The scores below the threshold never enter a combination */
+    for (const auto& entry : row) {
+        if (entry.score >= threshold) {
+            scores.push_back(entry.score);
+            columns.push_back(entry.column);
+        }
+    }
+
+    auto result = matching::best(scores, dof, threshold);
+
+    /* The indices of the kept scores become the columns */
+    for (auto& source : result.sources) {
+        source = columns[source];
+    }
+
+    return result;
+}
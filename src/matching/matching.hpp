@@ -0,0 +1,70 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_MATCHING_MATCHING_HPP_
+#define SRC_MATCHING_MATCHING_HPP_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "src/matrices/matrices.hpp"
+
+namespace matching {
+
+/**
+ * Representation of the sources matched to a file.
+ * 
+ * @param confidence the generalized probability of the matching
+ * @param sources the indices of the matched sources
+ * 
+ * @note zero confidence means that nothing was matched
+*/
+struct Matching {
+    double confidence;
+    std::vector<std::size_t> sources;
+};
+
+/**
+ * Matches the file with its most likely sources.
+ * 
+ * @param scores the similarity scores of the file and each candidate source
+ * @param dof the maximum number of sources
+ * @param threshold the minimum score of a source
+ * @return the matching with the highest confidence
+*/
+Matching best(const std::vector<double>& scores, std::size_t dof, double threshold);
+
+/**
+ * Matches the file with its most likely sources.
+ * 
+ * @param row the scores of the file reaching the threshold, as kept by a sparse matrix
+ * @param dof the maximum number of sources
+ * @param threshold the minimum score of a source
+ * @return the matching with the highest confidence, the sources being the columns
+ * 
+ * @note only the kept scores are combined, so sparse rows are matched much faster
+*/
+Matching best(std::span<const matrices::Entry> row, std::size_t dof, double threshold);
+
+}  // namespace matching
+
+#endif  // SRC_MATCHING_MATCHING_HPP_
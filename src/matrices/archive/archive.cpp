@@ -0,0 +1,370 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/matrices/archive/archive.hpp"
+
+#include <format>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace __matrices::archive {
+
+/* Archives are written in the native byte order */
+constexpr std::uint32_t magic = 0x324D5347;  // "GSM2"
+
+/* The run settled only the cells that could enter the top-DOF */
+constexpr std::uint32_t best_first = 1;
+
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t dof;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+    double threshold;
+    std::uint64_t blocks;
+    std::uint64_t blocks_count;
+    std::uint64_t submissions;
+    std::uint64_t submissions_count;
+    std::uint64_t strings;
+    std::uint64_t strings_count;
+};
+
+template <typename T>
+void put(std::ofstream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+std::span<const T> section(const memmap::File& file, std::uint64_t offset, std::uint64_t count) {
+    if (offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+        constexpr auto detail = "The matrix archive is corrupted";
+        throw std::runtime_error(detail);
+    }
+
+    return std::span<const T>(reinterpret_cast<const T*>(file.data() + offset), count);
+}
+
+}  // namespace __matrices::archive
+
+matrices::archive::Writer::Writer(
+    const std::filesystem::path& path,
+    double threshold,
+    int dof,
+    bool best_first
+) : path_(path), temporary_(path), threshold_(threshold), dof_(dof), best_first_(best_first) {
+    this->temporary_ += ".tmp";
+    this->stream_.open(this->temporary_, std::ios::binary | std::ios::trunc);
+
+    if (!this->stream_.is_open()) {
+        auto detail = std::format("Failed to open the file {}", this->temporary_.string());
+        throw std::runtime_error(detail);
+    }
+
+    /* The header is rewritten on commit, once the sections are known */
+    __matrices::archive::put(this->stream_, __matrices::archive::Header{});
+}
+
+matrices::archive::Writer::~Writer() {
+    if (this->committed_) {
+        return;
+    }
+
+    /* A failed run must not leave its partial archive behind */
+    this->stream_.close();
+
+    std::error_code error;
+    std::filesystem::remove(this->temporary_, error);
+}
+
+std::uint32_t matrices::archive::Writer::submission(
+    const std::string& name,
+    const std::vector<std::string>& labels
+) {
+    auto key = name;
+
+    for (const auto& label : labels) {
+        key.push_back('\0');
+        key.append(label);
+    }
+
+    if (auto iterator = this->registry_.find(key); iterator != this->registry_.end()) {
+        return iterator->second;
+    }
+
+    Submission submission{
+        static_cast<std::uint32_t>(this->strings_.size()),
+        static_cast<std::uint32_t>(this->strings_.size() + 1),
+        static_cast<std::uint32_t>(labels.size()),
+        0};
+
+    this->strings_.push_back(name);
+    this->strings_.insert(this->strings_.end(), labels.begin(), labels.end());
+
+    auto index = static_cast<std::uint32_t>(this->submissions_.size());
+    this->submissions_.push_back(submission);
+    this->registry_.emplace(std::move(key), index);
+
+    return index;
+}
+
+std::size_t matrices::archive::Writer::add(
+    std::uint32_t cheater,
+    std::uint32_t author,
+    const matrices::Sparse& matrix
+) {
+    if (matrix.rows() != this->submissions_.at(cheater).count
+        || matrix.columns() != this->submissions_.at(author).count) {
+        constexpr auto detail = "The matrix does not match the submissions";
+        throw std::runtime_error(detail);
+    }
+
+    Block block{cheater, author, 0, 0};
+
+    block.offsets = static_cast<std::uint64_t>(this->stream_.tellp());
+
+    std::uint64_t offset = 0;
+    __matrices::archive::put(this->stream_, offset);
+
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        offset += matrix.row(row).size();
+        __matrices::archive::put(this->stream_, offset);
+    }
+
+    block.entries = static_cast<std::uint64_t>(this->stream_.tellp());
+
+    for (std::size_t row = 0; row < matrix.rows(); ++row) {
+        auto entries = matrix.row(row);
+        this->stream_.write(
+            reinterpret_cast<const char*>(entries.data()),
+            entries.size_bytes());
+    }
+
+    this->blocks_.push_back(block);
+    return this->blocks_.size() - 1;
+}
+
+std::size_t matrices::archive::Writer::alias(
+    std::uint32_t cheater,
+    std::uint32_t author,
+    std::size_t block
+) {
+    auto original = this->blocks_.at(block);
+
+    if (this->submissions_.at(cheater).count != this->submissions_.at(original.cheater).count
+        || this->submissions_.at(author).count != this->submissions_.at(original.author).count) {
+        constexpr auto detail = "The matrix does not match the submissions";
+        throw std::runtime_error(detail);
+    }
+
+    this->blocks_.push_back(Block{cheater, author, original.offsets, original.entries});
+    return this->blocks_.size() - 1;
+}
+
+void matrices::archive::Writer::commit(void) {
+    __matrices::archive::Header header{
+        __matrices::archive::magic,
+        static_cast<std::uint32_t>(this->dof_),
+        this->best_first_ ? __matrices::archive::best_first : 0,
+        0,
+        this->threshold_,
+        0,
+        this->blocks_.size(),
+        0,
+        this->submissions_.size(),
+        0,
+        this->strings_.size()};
+
+    header.blocks = static_cast<std::uint64_t>(this->stream_.tellp());
+    for (const auto& block : this->blocks_) {
+        __matrices::archive::put(this->stream_, block);
+    }
+
+    header.submissions = static_cast<std::uint64_t>(this->stream_.tellp());
+    for (const auto& submission : this->submissions_) {
+        __matrices::archive::put(this->stream_, submission);
+    }
+
+    /* The characters follow the table of strings, which keeps it aligned */
+    header.strings = static_cast<std::uint64_t>(this->stream_.tellp());
+    std::uint64_t offset = header.strings + 2 * sizeof(std::uint64_t) * this->strings_.size();
+
+    for (const auto& string : this->strings_) {
+        __matrices::archive::put(this->stream_, offset);
+        __matrices::archive::put(this->stream_, static_cast<std::uint64_t>(string.size()));
+        offset += string.size();
+    }
+
+    for (const auto& string : this->strings_) {
+        this->stream_.write(string.data(), string.size());
+    }
+
+    this->stream_.seekp(0);
+    __matrices::archive::put(this->stream_, header);
+
+    this->stream_.close();
+
+    if (!this->stream_) {
+        std::filesystem::remove(this->temporary_);
+
+        auto detail = std::format("Failed to write the file {}", this->temporary_.string());
+        throw std::runtime_error(detail);
+    }
+
+    /* Readers never observe a partially written archive */
+    std::filesystem::rename(this->temporary_, this->path_);
+
+    this->committed_ = true;
+}
+
+matrices::archive::Reader::Reader(const std::filesystem::path& path) : file_(path) {
+    auto detail = std::format("The matrix archive {} is corrupted", path.string());
+
+    if (this->file_.size() < sizeof(__matrices::archive::Header)) {
+        throw std::runtime_error(detail);
+    }
+
+    const auto* header = reinterpret_cast<const __matrices::archive::Header*>(this->file_.data());
+
+    if (header->magic != __matrices::archive::magic) {
+        throw std::runtime_error(detail);
+    }
+
+    this->threshold_ = header->threshold;
+    this->dof_ = static_cast<int>(header->dof);
+    this->best_first_ = (header->flags & __matrices::archive::best_first) != 0;
+
+    this->blocks_ = __matrices::archive::section<Block>(
+        this->file_,
+        header->blocks,
+        header->blocks_count);
+
+    this->submissions_ = __matrices::archive::section<Submission>(
+        this->file_,
+        header->submissions,
+        header->submissions_count);
+
+    this->strings_ = __matrices::archive::section<std::uint64_t>(
+        this->file_,
+        header->strings,
+        2 * header->strings_count);
+
+    for (std::size_t string = 0; string < header->strings_count; ++string) {
+        __matrices::archive::section<char>(
+            this->file_,
+            this->strings_[2 * string],
+            this->strings_[2 * string + 1]);
+    }
+
+    for (const auto& submission : this->submissions_) {
+        if (submission.name >= header->strings_count
+            || submission.first > header->strings_count
+            || submission.count > header->strings_count - submission.first) {
+            throw std::runtime_error(detail);
+        }
+    }
+
+    /* The rows are served without checks, so every block is validated once */
+    for (const auto& block : this->blocks_) {
+        if (block.cheater >= this->submissions_.size() || block.author >= this->submissions_.size()) {
+            throw std::runtime_error(detail);
+        }
+
+        auto rows = this->submissions_[block.cheater].count;
+        auto columns = this->submissions_[block.author].count;
+
+        auto offsets = __matrices::archive::section<std::uint64_t>(this->file_, block.offsets, rows + 1);
+        auto entries = __matrices::archive::section<Entry>(this->file_, block.entries, offsets[rows]);
+
+        for (std::size_t row = 0; row < rows; ++row) {
+            if (offsets[row] > offsets[row + 1]) {
+                throw std::runtime_error(detail);
+            }
+        }
+
+        for (const auto& entry : entries) {
+            if (entry.column >= columns) {
+                throw std::runtime_error(detail);
+            }
+        }
+    }
+}
+
+double matrices::archive::Reader::threshold(void) const {
+    return this->threshold_;
+}
+
+int matrices::archive::Reader::dof(void) const {
+    return this->dof_;
+}
+
+bool matrices::archive::Reader::best_first(void) const {
+    return this->best_first_;
+}
+
+std::size_t matrices::archive::Reader::size(void) const {
+    return this->blocks_.size();
+}
+
+matrices::archive::Pair matrices::archive::Reader::pair(std::size_t block) const {
+    const auto& lhs = this->lookup(this->blocks_[block].cheater);
+    const auto& rhs = this->lookup(this->blocks_[block].author);
+
+    Pair pair;
+
+    pair.cheater = this->text(lhs.name);
+    pair.author = this->text(rhs.name);
+
+    for (std::uint32_t idx = 0; idx < lhs.count; ++idx) {
+        pair.lhs_labels.emplace_back(this->text(lhs.first + idx));
+    }
+
+    for (std::uint32_t idx = 0; idx < rhs.count; ++idx) {
+        pair.rhs_labels.emplace_back(this->text(rhs.first + idx));
+    }
+
+    return pair;
+}
+
+std::span<const matrices::Entry> matrices::archive::Reader::row(
+    std::size_t block,
+    std::size_t row
+) const {
+    const auto& location = this->blocks_[block];
+
+    const auto* offsets = reinterpret_cast<const std::uint64_t*>(this->file_.data() + location.offsets);
+    const auto* entries = reinterpret_cast<const Entry*>(this->file_.data() + location.entries);
+
+    return std::span<const Entry>(entries + offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+std::string_view matrices::archive::Reader::text(std::uint32_t string) const {
+    auto offset = this->strings_[2 * string];
+    auto length = this->strings_[2 * string + 1];
+
+    return std::string_view(this->file_.data() + offset, length);
+}
+
+const matrices::archive::Submission& matrices::archive::Reader::lookup(
+    std::uint32_t submission
+) const {
+    return this->submissions_[submission];
+}
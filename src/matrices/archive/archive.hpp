@@ -0,0 +1,241 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_MATRICES_ARCHIVE_ARCHIVE_HPP_
+#define SRC_MATRICES_ARCHIVE_ARCHIVE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/memmap/memmap.hpp"
+
+#include "src/matrices/matrices.hpp"
+
+namespace matrices::archive {
+
+/**
+ * Submission pair of the archive with the labels of its files.
+ * 
+ * @param cheater the name of the lhs submission
+ * @param author the name of the rhs submission
+ * @param lhs_labels the labels of the rows
+ * @param rhs_labels the labels of the columns
+*/
+struct Pair {
+    std::string cheater;
+    std::string author;
+    std::vector<std::string> lhs_labels;
+    std::vector<std::string> rhs_labels;
+};
+
+/**
+ * Location of the scores of a submission pair within the archive.
+ * 
+ * @param cheater the index of the lhs submission
+ * @param author the index of the rhs submission
+ * @param offsets the file offset of the row offsets
+ * @param entries the file offset of the entries
+*/
+struct Block {
+    std::uint32_t cheater;
+    std::uint32_t author;
+    std::uint64_t offsets;
+    std::uint64_t entries;
+};
+
+/**
+ * Submission of the archive, its name and labels being indices of strings.
+ * 
+ * @param name the index of the name
+ * @param first the index of the first label
+ * @param count the number of labels
+*/
+struct Submission {
+    std::uint32_t name;
+    std::uint32_t first;
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+
+/**
+ * Writes the sparse score matrices of a run, one block per submission pair.
+ * 
+ * @note the scores are streamed to the disk, only the names are kept in memory
+ * @note the archive appears at the path only when committed
+ * @note only the scores reaching the threshold are expected, the lower ones may be inexact
+*/
+class Writer {
+ public:
+    /**
+     * Creates an empty archive.
+     * 
+     * @param path the path to the archive
+     * @param threshold the alpha-threshold of the run
+     * @param dof the degree of freedom of the run
+     * @param best_first if the run evaluated the rows best-first
+    */
+    Writer(const std::filesystem::path& path, double threshold, int dof, bool best_first);
+
+    /**
+     * Removes the temporary file unless the archive was committed.
+    */
+    ~Writer();
+
+    /**
+     * Registers the submission, once per distinct list of labels.
+     * 
+     * @param name the name of the submission
+     * @param labels the labels of its files
+     * @return the index of the submission
+    */
+    std::uint32_t submission(const std::string& name, const std::vector<std::string>& labels);
+
+    /**
+     * Writes the scores of the submission pair.
+     * 
+     * @param cheater the index of the lhs submission
+     * @param author the index of the rhs submission
+     * @param matrix the scores
+     * @return the index of the block
+    */
+    std::size_t add(std::uint32_t cheater, std::uint32_t author, const matrices::Sparse& matrix);
+
+    /**
+     * Reuses the scores of a block for another submission pair.
+     * 
+     * @param cheater the index of the lhs submission
+     * @param author the index of the rhs submission
+     * @param block the index of the block with the same scores
+     * @return the index of the block
+    */
+    std::size_t alias(std::uint32_t cheater, std::uint32_t author, std::size_t block);
+
+    /**
+     * Writes the names and moves the archive to its path.
+     * 
+     * @note nothing may be added afterwards
+    */
+    void commit(void);
+
+ private:
+    std::filesystem::path path_;
+    std::filesystem::path temporary_;
+    std::ofstream stream_;
+
+    double threshold_;
+    int dof_;
+    bool best_first_;
+
+    std::vector<Block> blocks_;
+    std::vector<Submission> submissions_;
+    std::vector<std::string> strings_;
+
+    std::unordered_map<std::string, std::uint32_t> registry_;
+
+    bool committed_ = false;
+};
+
+/**
+ * Read-only view of an archive mapped into memory.
+ * 
+ * @note the rows point directly into the mapping
+*/
+class Reader {
+ public:
+    /**
+     * Maps and validates the archive.
+     * 
+     * @param path the path to the archive
+    */
+    explicit Reader(const std::filesystem::path& path);
+
+    /**
+     * Returns the alpha-threshold of the run.
+     * 
+     * @return the threshold
+    */
+    double threshold(void) const;
+
+    /**
+     * Returns the degree of freedom of the run.
+     * 
+     * @return the degree of freedom
+    */
+    int dof(void) const;
+
+    /**
+     * Checks if the run evaluated the rows best-first.
+     * 
+     * @return if the cells beyond the top-DOF of the run may be missing
+    */
+    bool best_first(void) const;
+
+    /**
+     * Returns the number of submission pairs.
+     * 
+     * @return the number of blocks
+    */
+    std::size_t size(void) const;
+
+    /**
+     * Returns the names of the submission pair.
+     * 
+     * @param block the index of the block
+     * @return the submission pair
+    */
+    Pair pair(std::size_t block) const;
+
+    /**
+     * Returns the non-zero scores of the row.
+     * 
+     * @param block the index of the block
+     * @param row the index of the lhs file
+     * @return the entries in the order of the columns
+    */
+    std::span<const Entry> row(std::size_t block, std::size_t row) const;
+
+ private:
+    memmap::File file_;
+
+    double threshold_;
+    int dof_;
+    bool best_first_;
+
+    std::span<const Block> blocks_;
+    std::span<const Submission> submissions_;
+
+    /* The offset and the length of every string, in pairs */
+    std::span<const std::uint64_t> strings_;
+
+    std::string_view text(std::uint32_t string) const;
+    const Submission& lookup(std::uint32_t submission) const;
+};
+
+}  // namespace matrices::archive
+
+#endif  // SRC_MATRICES_ARCHIVE_ARCHIVE_HPP_
@@ -0,0 +1,200 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/matrices/archive/archive.hpp"
+#include "src/matrices/matrices.hpp"
+
+namespace __matrices::archive::test {
+
+const auto directory = std::filesystem::temp_directory_path() / "gelada-archive-test";
+const auto path = directory / "scores.bin";
+const auto copy = directory / "copy.bin";
+
+matrices::Dense scores(void) {
+    matrices::Dense dense(2, 3, 0.5);
+
+    dense.set(0, 1, 0.75);
+    dense.set(1, 0, 0.5);
+    dense.set(1, 2, 1.0);
+    dense.set(0, 2, 0.25);
+
+    return dense;
+}
+
+bool equal(std::span<const matrices::Entry> lhs, std::span<const matrices::Entry> rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for (std::size_t idx = 0; idx < lhs.size(); ++idx) {
+        if (lhs[idx].column != rhs[idx].column || lhs[idx].score != rhs[idx].score) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void write(void) {
+    matrices::archive::Writer writer(path, 0.5, 3, true);
+
+    auto alice = writer.submission("alice", {"a.py", "b.py"});
+    auto bob = writer.submission("bob", {"a.py", "b.py", "c.py"});
+    auto carol = writer.submission("carol", {"x.py", "y.py"});
+
+    auto block = writer.add(alice, bob, matrices::Sparse(scores()));
+    writer.alias(carol, bob, block);
+
+    writer.commit();
+}
+
+/* The settings, the names and the rows are read back as written */
+bool roundtrip(void) {
+    matrices::archive::Reader reader(path);
+
+    if (reader.threshold() != 0.5 || reader.dof() != 3 || !reader.best_first() || reader.size() != 2) {
+        return false;
+    }
+
+    auto first = reader.pair(0);
+    auto second = reader.pair(1);
+
+    auto named = first.cheater == "alice"
+        && first.author == "bob"
+        && first.lhs_labels == std::vector<std::string>{"a.py", "b.py"}
+        && first.rhs_labels == std::vector<std::string>{"a.py", "b.py", "c.py"}
+        && second.cheater == "carol"
+        && second.lhs_labels == std::vector<std::string>{"x.py", "y.py"};
+
+    if (!named) {
+        return false;
+    }
+
+    matrices::Sparse expected(scores());
+
+    for (std::size_t block = 0; block < reader.size(); ++block) {
+        for (std::size_t row = 0; row < expected.rows(); ++row) {
+            if (!equal(reader.row(block, row), expected.row(row))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool rejected(const std::string& bytes) {
+    std::ofstream stream(copy, std::ios::binary | std::ios::trunc);
+    stream.write(bytes.data(), bytes.size());
+    stream.close();
+
+    try {
+        matrices::archive::Reader reader(copy);
+    }
+    catch (const std::runtime_error&) {
+        return true;
+    }
+
+    return false;
+}
+
+/* A wrong magic or a missing byte never yields an archive */
+bool corrupted(void) {
+    std::ifstream stream(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    auto magic = bytes;
+    magic[0] ^= 0x01;
+
+    if (!rejected(magic)) {
+        return false;
+    }
+
+    for (std::size_t size = 0; size < bytes.size(); ++size) {
+        if (!rejected(bytes.substr(0, size))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* An uncommitted archive leaves no file behind */
+bool abandoned(void) {
+    auto other = directory / "abandoned.bin";
+
+    {
+        matrices::archive::Writer writer(other, 0.5, 3, false);
+        writer.submission("alice", {"a.py"});
+    }
+
+    auto temporary = other;
+    temporary += ".tmp";
+
+    return !std::filesystem::exists(other) && !std::filesystem::exists(temporary);
+}
+
+}  // namespace __matrices::archive::test
+
+int main() {
+    namespace test = __matrices::archive::test;
+
+    try {
+        std::filesystem::remove_all(test::directory);
+        std::filesystem::create_directories(test::directory);
+
+        test::write();
+
+        if (!test::roundtrip()) {
+            logging::error("The archive differs from the written scores");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::corrupted()) {
+            logging::error("The corrupted archive was accepted");
+            return EXIT_FAILURE;
+        }
+
+        if (!test::abandoned()) {
+            logging::error("The uncommitted archive was left behind");
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove_all(test::directory);
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/matrices/matrices.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace __matrices::rounding {
+
+/* The nearest float on the same side of the threshold as the score */
+float narrow(double score, double threshold) {
+    auto value = static_cast<float>(score);
+
+    if (score >= threshold && value < threshold) {
+        value = std::nextafter(value, std::numeric_limits<float>::infinity());
+    }
+
+    if (score < threshold && value >= threshold) {
+        value = std::nextafter(value, -std::numeric_limits<float>::infinity());
+    }
+
+    return value;
+}
+
+}  // namespace __matrices::rounding
+
+matrices::Dense::Dense(std::size_t rows, std::size_t columns, double threshold)
+    : rows_(rows), columns_(columns), threshold_(threshold), scores_(rows * columns, 0.0f) {
+    if (columns > std::numeric_limits<std::uint32_t>::max()) {
+        constexpr auto detail = "The number of columns exceeds the limit";
+        throw std::runtime_error(detail);
+    }
+}
+
+std::size_t matrices::Dense::rows() const {
+    return this->rows_;
+}
+
+std::size_t matrices::Dense::columns() const {
+    return this->columns_;
+}
+
+double matrices::Dense::threshold() const {
+    return this->threshold_;
+}
+
+void matrices::Dense::set(std::size_t row, std::size_t column, double score) {
+    auto value = __matrices::rounding::narrow(score, this->threshold_);
+    this->scores_[row * this->columns_ + column] = value;
+}
+
+double matrices::Dense::get(std::size_t row, std::size_t column) const {
+    return this->scores_[row * this->columns_ + column];
+}
+
+matrices::Sparse::Sparse(const Dense& dense) : Sparse(dense, dense.threshold()) {}
+
+matrices::Sparse::Sparse(const Dense& dense, double threshold)
+    : rows_(dense.rows()), columns_(dense.columns()) {
+    this->offsets_.reserve(this->rows_ + 1);
+    this->offsets_.push_back(0);
+
+    for (std::size_t row = 0; row < this->rows_; ++row) {
+        for (std::size_t column = 0; column < this->columns_; ++column) {
+            auto score = dense.get(row, column);
+
+            /* A zero score never raises the confidence of a matching */
+            if (score > 0.0 && score >= threshold) {
+                auto entry = Entry{static_cast<std::uint32_t>(column), static_cast<float>(score)};
+                this->entries_.push_back(entry);
+            }
+        }
+
+        this->offsets_.push_back(this->entries_.size());
+    }
+
+    this->entries_.shrink_to_fit();
+}
+
+std::size_t matrices::Sparse::rows() const {
+    return this->rows_;
+}
+
+std::size_t matrices::Sparse::columns() const {
+    return this->columns_;
+}
+
+std::size_t matrices::Sparse::size() const {
+    return this->entries_.size();
+}
+
+std::span<const matrices::Entry> matrices::Sparse::row(std::size_t row) const {
+    auto first = this->offsets_[row];
+    auto last = this->offsets_[row + 1];
+
+    return std::span<const Entry>(this->entries_.data() + first, last - first);
+}
@@ -0,0 +1,168 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_MATRICES_MATRICES_HPP_
+#define SRC_MATRICES_MATRICES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace matrices {
+
+/**
+ * Score of a file pair kept by a sparse matrix.
+ * 
+ * @param column the index of the rhs file
+ * @param score the similarity score
+*/
+struct Entry {
+    std::uint32_t column;
+    float score;
+};
+
+/**
+ * Scores of the file pairs of two submissions, stored row-major in one block.
+ * 
+ * @note scores are kept in single precision, on the same side of the threshold
+ * @note distinct cells may be set concurrently
+*/
+class Dense {
+ public:
+    /**
+     * Creates the matrix of zeros.
+     * 
+     * @param rows the number of lhs files
+     * @param columns the number of rhs files
+     * @param threshold the alpha-threshold
+    */
+    Dense(std::size_t rows, std::size_t columns, double threshold);
+
+    /**
+     * Returns the number of rows.
+     * 
+     * @return the number of lhs files
+    */
+    std::size_t rows() const;
+
+    /**
+     * Returns the number of columns.
+     * 
+     * @return the number of rhs files
+    */
+    std::size_t columns() const;
+
+    /**
+     * Returns the alpha-threshold.
+     * 
+     * @return the threshold
+    */
+    double threshold() const;
+
+    /**
+     * Sets the score of the cell.
+     * 
+     * @param row the index of the lhs file
+     * @param column the index of the rhs file
+     * @param score the similarity score
+    */
+    void set(std::size_t row, std::size_t column, double score);
+
+    /**
+     * Returns the score of the cell.
+     * 
+     * @param row the index of the lhs file
+     * @param column the index of the rhs file
+     * @return the similarity score
+    */
+    double get(std::size_t row, std::size_t column) const;
+
+ private:
+    std::size_t rows_;
+    std::size_t columns_;
+    double threshold_;
+
+    std::vector<float> scores_;
+};
+
+/**
+ * Non-zero scores reaching the threshold, in the compressed sparse row format.
+ * 
+ * @note the matchings depend only on such scores
+*/
+class Sparse {
+ public:
+    /**
+     * Compresses the dense matrix, keeping the scores reaching its threshold.
+     * 
+     * @param dense the dense matrix
+    */
+    explicit Sparse(const Dense& dense);
+
+    /**
+     * Compresses the dense matrix, keeping the scores reaching the threshold.
+     * 
+     * @param dense the dense matrix
+     * @param threshold the smallest score kept
+    */
+    Sparse(const Dense& dense, double threshold);
+
+    /**
+     * Returns the number of rows.
+     * 
+     * @return the number of lhs files
+    */
+    std::size_t rows() const;
+
+    /**
+     * Returns the number of columns.
+     * 
+     * @return the number of rhs files
+    */
+    std::size_t columns() const;
+
+    /**
+     * Returns the number of scores kept.
+     * 
+     * @return the number of entries
+    */
+    std::size_t size() const;
+
+    /**
+     * Returns the scores of the row reaching the threshold.
+     * 
+     * @param row the index of the lhs file
+     * @return the entries in the order of the columns
+    */
+    std::span<const Entry> row(std::size_t row) const;
+
+ private:
+    std::size_t rows_;
+    std::size_t columns_;
+
+    std::vector<std::size_t> offsets_;
+    std::vector<Entry> entries_;
+};
+
+}  // namespace matrices
+
+#endif  // SRC_MATRICES_MATRICES_HPP_
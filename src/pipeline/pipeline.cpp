@@ -0,0 +1,535 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/pipeline/pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "src/estimators/alpha/alpha.hpp"
+#include "src/kernels/kernels.hpp"
+
+namespace __pipeline {
+
+constexpr double epsilon = 1e-9;
+
+/* The token estimators never run Levenshtein, so the kernels are not measured */
+planner::Throughput throughput(bool gst) {
+    return gst ? planner::Throughput{1.0, 1.0, 0.0} : planner::measure();
+}
+
+}  // namespace __pipeline
+
+namespace pipeline {
+
+Pipeline::Pipeline(const Options& options, contents::Store& contents, BS::thread_pool& pool)
+    : options_(options),
+      contents_(contents),
+      gst_(options.estimator == "gst" || options.estimator == "fragments"),
+      batched_(!this->gst_ && !options.chunking && !options.approximate),
+      embeddings_(options.repetitions),
+      strategist_(options.threshold, pool, __pipeline::throughput(this->gst_)) {}
+
+void Pipeline::classify(const Submissions& files, const languages::Table& compatibilities, BS::thread_pool& pool) {
+    this->compatibilities_ = compatibilities;
+
+    std::mutex mutex;
+
+    for (const auto& [name, submission_files] : files) {
+        for (const auto& file : submission_files) {
+            auto task = pool.submit_task([&, file]{
+                auto language = languages::detect(file);
+
+                std::lock_guard lock(mutex);
+                this->dialects_[file.string()] = language;
+            });
+        }
+    }
+
+    pool.wait();
+}
+
+void Pipeline::bucket(const Submissions& files, std::size_t bands, std::size_t rows, BS::thread_pool& pool) {
+    lsh::Index buckets(bands, rows);
+
+    for (const auto& [name, submission_files] : files) {
+        for (const auto& file : submission_files) {
+            auto task = pool.submit_task([&, file]{
+                const auto& content = this->contents_.load(file);
+                buckets.add(content.digest, content.fingerprints);
+            });
+        }
+    }
+
+    pool.wait();
+
+    for (const auto& [lhs, rhs] : buckets.candidates()) {
+        this->neighbours_[lhs].insert(rhs);
+        this->neighbours_[rhs].insert(lhs);
+    }
+
+    this->bucketed_ = true;
+}
+
+void Pipeline::cover(const Submissions& files) {
+    std::vector<const std::vector<std::uint32_t>*> tokens;
+    std::vector<std::size_t> groups;
+
+    std::size_t group = 0;
+
+    for (const auto& [name, submission_files] : files) {
+        for (const auto& file : submission_files) {
+            const auto& content = this->contents_.load(file);
+
+            this->streams_[&content] = tokens.size();
+            tokens.push_back(&content.tokens);
+            groups.push_back(group);
+        }
+
+        group += 1;
+    }
+
+    fragments::Index suffixes(tokens, groups);
+    this->coverage_ = std::make_unique<fragments::Coverage>(
+        suffixes,
+        suffixes.enumerate(this->options_.gst_minimum));
+}
+
+bool Pipeline::compatible(const contents::Content& lhs, const contents::Content& rhs) {
+    if (this->compatibilities_.compatible(this->dialect_(lhs), this->dialect_(rhs))) {
+        return true;
+    }
+
+    this->incompatible_ += 1;
+    return false;
+}
+
+Screening Pipeline::triage(const contents::Content& lhs, const contents::Content& rhs) {
+    if (!this->compatible(lhs, rhs)) {
+        return Screening{Verdict::skipped, 0.0};
+    }
+
+    if (this->bucketed_ && !this->collide_(lhs, rhs)) {
+        this->pruned_ += 1;
+        return Screening{Verdict::skipped, 0.0};
+    }
+
+    if (auto score = this->screen_(lhs, rhs)) {
+        return Screening{Verdict::scored, *score};
+    }
+
+    /* The approximations consult the cache only when verified */
+    if (this->options_.cache && !this->options_.approximate) {
+        if (auto cached = scorecache::tryread(this->key_(lhs, rhs))) {
+            return Screening{Verdict::scored, *cached};
+        }
+    }
+
+    return Screening{Verdict::pending, 0.0};
+}
+
+double Pipeline::estimate(const contents::Content& lhs, const contents::Content& rhs) {
+    if (auto score = this->screen_(lhs, rhs)) {
+        return *score;
+    }
+
+    if (this->options_.cache && !this->options_.approximate) {
+        if (auto cached = scorecache::tryread(this->key_(lhs, rhs))) {
+            return *cached;
+        }
+    }
+
+    return this->score_(lhs, rhs);
+}
+
+double Pipeline::bound(const contents::Content& lhs, const sketches::Sketch& sketch) const {
+    /* Token tiles, units and CGK estimates are not bounded by the sketch */
+    auto unbounded = this->gst_ || this->options_.chunking || this->options_.approximate;
+    auto exact_bound = unbounded ? 1.0 : sketches::levenshtein(lhs, sketch);
+
+    /* Such pairs fall back to the exact estimator */
+    if (lhs.fingerprints.empty()) {
+        return exact_bound;
+    }
+
+    auto winnowing_bound = sketches::winnowing(lhs, sketch);
+
+    if (this->options_.estimator == "winnowing") {
+        return sketch.fingerprinted
+            ? winnowing_bound
+            : std::max(winnowing_bound, exact_bound);
+    }
+
+    auto prefilter = this->options_.prefilter;
+
+    if (prefilter && sketch.fingerprinted && winnowing_bound < *prefilter) {
+        return 0.0;
+    }
+
+    return exact_bound;
+}
+
+void Pipeline::fill(
+    matrices::Dense& matrix,
+    std::size_t lidx,
+    const std::vector<std::filesystem::path>& lhs_files,
+    const std::vector<std::filesystem::path>& rhs_files,
+    std::size_t first,
+    std::size_t last
+) {
+    const auto& lhs = this->contents_.load(lhs_files[lidx]);
+
+    std::vector<const contents::Content*> candidates;
+    std::vector<std::size_t> columns;
+    double predicted = 0.0;
+
+    for (std::size_t ridx = first; ridx < last; ++ridx) {
+        const auto& rhs = this->contents_.load(rhs_files[ridx]);
+
+        auto screening = this->triage(lhs, rhs);
+
+        if (screening.verdict == Verdict::skipped) {
+            continue;
+        }
+
+        if (screening.verdict == Verdict::scored) {
+            matrix.set(lidx, ridx, screening.score);
+            continue;
+        }
+
+        if (!this->batched_) {
+            matrix.set(lidx, ridx, this->score_(lhs, rhs));
+            continue;
+        }
+
+        auto plan = this->strategist_.plan(lhs, rhs);
+
+        if (auto score = this->solo_(plan, lhs, rhs)) {
+            matrix.set(lidx, ridx, *score);
+            continue;
+        }
+
+        candidates.push_back(&rhs);
+        columns.push_back(ridx);
+        predicted += plan.cost;
+    }
+
+    if (candidates.empty()) {
+        return;
+    }
+
+    auto scores = this->batch_(lhs, candidates, predicted);
+
+    for (std::size_t idx = 0; idx < columns.size(); ++idx) {
+        matrix.set(lidx, columns[idx], scores[idx]);
+    }
+}
+
+void Pipeline::descend(
+    matrices::Dense& matrix,
+    std::size_t lidx,
+    const std::vector<std::filesystem::path>& lhs_files,
+    const std::vector<std::filesystem::path>& rhs_files
+) {
+    const auto& lhs = this->contents_.load(lhs_files[lidx]);
+
+    auto dof = static_cast<std::size_t>(this->options_.dof);
+    auto threshold = this->options_.threshold;
+
+    /* The DOF best scores so far, the smallest one on top */
+    std::vector<double> best;
+
+    auto settle = [&](std::size_t ridx, double score) {
+        matrix.set(lidx, ridx, score);
+
+        best.push_back(score);
+        std::push_heap(best.begin(), best.end(), std::greater<>{});
+
+        if (best.size() > dof) {
+            std::pop_heap(best.begin(), best.end(), std::greater<>{});
+            best.pop_back();
+        }
+    };
+
+    /* A cell below both the threshold and the DOF best never enters the matching */
+    auto cutoff = [&] {
+        return best.size() == dof ? std::max(threshold, best.front()) : threshold;
+    };
+
+    std::vector<std::pair<double, std::size_t>> queue;
+
+    for (std::size_t ridx = 0; ridx < rhs_files.size(); ++ridx) {
+        const auto& rhs = this->contents_.load(rhs_files[ridx]);
+
+        auto screening = this->triage(lhs, rhs);
+
+        if (screening.verdict == Verdict::skipped) {
+            continue;
+        }
+
+        if (screening.verdict == Verdict::scored) {
+            settle(ridx, screening.score);
+            continue;
+        }
+
+        queue.emplace_back(sketches::levenshtein(lhs, rhs), ridx);
+    }
+
+    std::stable_sort(queue.begin(), queue.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    std::size_t next = 0;
+
+    while (next < queue.size() && queue[next].first + __pipeline::epsilon >= cutoff()) {
+        std::vector<const contents::Content*> candidates;
+        std::vector<std::size_t> columns;
+        double predicted = 0.0;
+
+        /* The candidates of a batch are taken under the same cutoff */
+        while (next < queue.size() && candidates.size() < kernels::lanes) {
+            if (queue[next].first + __pipeline::epsilon < cutoff()) {
+                break;
+            }
+
+            auto ridx = queue[next++].second;
+            const auto& rhs = this->contents_.load(rhs_files[ridx]);
+
+            auto plan = this->strategist_.plan(lhs, rhs);
+
+            if (auto score = this->solo_(plan, lhs, rhs)) {
+                settle(ridx, *score);
+                continue;
+            }
+
+            candidates.push_back(&rhs);
+            columns.push_back(ridx);
+            predicted += plan.cost;
+        }
+
+        if (candidates.empty()) {
+            continue;
+        }
+
+        auto scores = this->batch_(lhs, candidates, predicted);
+
+        for (std::size_t idx = 0; idx < columns.size(); ++idx) {
+            settle(columns[idx], scores[idx]);
+        }
+    }
+
+    this->deferred_ += queue.size() - next;
+}
+
+bool Pipeline::batched(void) const {
+    return this->batched_;
+}
+
+Statistics Pipeline::statistics(void) const {
+    return Statistics{
+        this->incompatible_.load(),
+        this->pruned_.load(),
+        this->duplicates_.load(),
+        this->prefiltered_.load(),
+        this->verified_.load(),
+        this->batches_.load(),
+        this->deferred_.load()};
+}
+
+std::vector<std::string> Pipeline::explain(void) const {
+    /* The token estimators never run the plans */
+    if (this->gst_) {
+        return {};
+    }
+
+    return this->strategist_.explain();
+}
+
+/* Both estimators are symmetric, so both orders share the key */
+scorecache::Key Pipeline::key_(const contents::Content& lhs, const contents::Content& rhs) const {
+    return scorecache::Key{
+        std::min(lhs.digest, rhs.digest),
+        std::max(lhs.digest, rhs.digest),
+        std::format(
+            "{}{}",
+            this->options_.chunking ? "chunked-" : "",
+            this->gst_ ? std::format("gst{}", this->options_.gst_minimum) : "levenshtein"),
+        this->options_.normalization};
+}
+
+/* Every cohort file is classified once, the corpus files only by their names */
+std::string Pipeline::dialect_(const contents::Content& content) const {
+    auto iterator = this->dialects_.find(content.path.string());
+    if (iterator != this->dialects_.end()) {
+        return iterator->second;
+    }
+
+    return languages::detect(content.path);
+}
+
+/* Files shorter than a k-gram are not indexed, they collide with everything */
+bool Pipeline::collide_(const contents::Content& lhs, const contents::Content& rhs) const {
+    if (lhs.fingerprints.empty() || rhs.fingerprints.empty() || lhs.digest == rhs.digest) {
+        return true;
+    }
+
+    auto iterator = this->neighbours_.find(lhs.digest);
+    return iterator != this->neighbours_.end() && iterator->second.contains(rhs.digest);
+}
+
+/* Scores the pair without the exact estimator, if possible */
+std::optional<double> Pipeline::screen_(const contents::Content& lhs, const contents::Content& rhs) {
+    /* Identical files score one under every estimator */
+    if (lhs.digest == rhs.digest) {
+        this->duplicates_ += 1;
+        return 1.0;
+    }
+
+    /* Files shorter than a k-gram have no fingerprints */
+    auto fingerprinted = !lhs.fingerprints.empty() && !rhs.fingerprints.empty();
+
+    if (fingerprinted && this->options_.estimator == "winnowing") {
+        return estimators::alpha::winnowing(lhs.fingerprints, rhs.fingerprints);
+    }
+
+    if (fingerprinted && this->options_.prefilter) {
+        auto overlap = estimators::alpha::winnowing(lhs.fingerprints, rhs.fingerprints);
+        if (overlap < *this->options_.prefilter) {
+            this->prefiltered_ += 1;
+            return 0.0;
+        }
+    }
+
+    /* The cohort pairs are scored by the fragments found in a single pass */
+    if (this->coverage_) {
+        auto lhs_stream = this->streams_.find(&lhs);
+        auto rhs_stream = this->streams_.find(&rhs);
+
+        if (lhs_stream != this->streams_.end() && rhs_stream != this->streams_.end()) {
+            return this->coverage_->score(lhs_stream->second, rhs_stream->second);
+        }
+    }
+
+    return std::nullopt;
+}
+
+planner::Outcome Pipeline::compute_(const contents::Content& lhs, const contents::Content& rhs) {
+    auto minimum = this->options_.gst_minimum;
+
+    if (this->options_.chunking) {
+        const auto& lhs_units = this->units_.load(lhs);
+        const auto& rhs_units = this->units_.load(rhs);
+
+        return planner::Outcome{
+            this->gst_
+                ? chunks::gst(lhs_units, rhs_units, minimum)
+                : chunks::levenshtein(lhs_units, rhs_units),
+            true};
+    }
+
+    if (this->gst_) {
+        return planner::Outcome{estimators::alpha::gst(lhs.tokens, rhs.tokens, minimum), true};
+    }
+
+    return this->strategist_.run(this->strategist_.plan(lhs, rhs), lhs, rhs);
+}
+
+/* Scores the screened pair by the exact estimator, or by its approximation */
+double Pipeline::score_(const contents::Content& lhs, const contents::Content& rhs) {
+    if (this->options_.approximate) {
+        auto score = cgk::similarity(this->embeddings_.load(lhs), this->embeddings_.load(rhs));
+        auto margin = this->options_.verify_margin;
+
+        /* Only the scores deciding the matching are worth the quadratic time */
+        if (!margin || std::abs(score - this->options_.threshold) > *margin) {
+            return score;
+        }
+
+        this->verified_ += 1;
+
+        if (this->options_.cache) {
+            if (auto cached = scorecache::tryread(this->key_(lhs, rhs))) {
+                return *cached;
+            }
+        }
+    }
+
+    /* Scores below the threshold may be inexact, they are not worth keeping */
+    auto outcome = this->compute_(lhs, rhs);
+    if (this->options_.cache && outcome.exact) {
+        scorecache::write(this->key_(lhs, rhs), outcome.score);
+    }
+
+    return outcome.score;
+}
+
+/* Runs the plan of the pair, unless it is left to the batched kernel */
+std::optional<double> Pipeline::solo_(
+    const planner::Plan& plan,
+    const contents::Content& lhs,
+    const contents::Content& rhs
+) {
+    if (plan.strategy == planner::Strategy::bitparallel) {
+        return std::nullopt;
+    }
+
+    auto outcome = this->strategist_.run(plan, lhs, rhs);
+
+    /* Scores below the threshold may be inexact, they are not worth keeping */
+    if (this->options_.cache && outcome.exact) {
+        scorecache::write(this->key_(lhs, rhs), outcome.score);
+    }
+
+    return outcome.score;
+}
+
+/* Compares the file with the candidates by one bit-parallel kernel call per lane batch */
+std::vector<double> Pipeline::batch_(
+    const contents::Content& lhs,
+    const std::vector<const contents::Content*>& candidates,
+    double predicted
+) {
+    this->batches_ += 1;
+
+    std::vector<const std::string*> texts;
+    for (const auto* rhs : candidates) {
+        texts.push_back(&rhs->text);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto scores = estimators::alpha::levenshtein(lhs.text, texts);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    this->strategist_.record(planner::Strategy::bitparallel, candidates.size(), predicted, elapsed.count());
+
+    for (std::size_t idx = 0; idx < candidates.size() && this->options_.cache; ++idx) {
+        scorecache::write(this->key_(lhs, *candidates[idx]), scores[idx]);
+    }
+
+    return scores;
+}
+
+}  // namespace pipeline
@@ -0,0 +1,317 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_PIPELINE_PIPELINE_HPP_
+#define SRC_PIPELINE_PIPELINE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "src/cgk/cgk.hpp"
+#include "src/chunks/chunks.hpp"
+#include "src/contents/contents.hpp"
+#include "src/fragments/fragments.hpp"
+#include "src/languages/languages.hpp"
+#include "src/lsh/lsh.hpp"
+#include "src/matrices/matrices.hpp"
+#include "src/planner/planner.hpp"
+#include "src/scorecache/scorecache.hpp"
+#include "src/sketches/sketches.hpp"
+
+namespace pipeline {
+
+/**
+ * The files of every submission, by the name of the submission.
+*/
+using Submissions = std::unordered_map<std::string, std::vector<std::filesystem::path>>;
+
+/**
+ * Settings of the pair scoring.
+ * 
+ * @param estimator the name of the similarity estimator
+ * @param normalization the version of the normalization, part of the cache keys
+ * @param threshold the alpha-threshold
+ * @param dof the degree of freedom
+ * @param gst_minimum the minimum tile length of the token estimators
+ * @param chunking whether the functions and classes are compared instead of whole files
+ * @param approximate whether the files are compared by their CGK embeddings
+ * @param repetitions the number of CGK walks per file
+ * @param verify_margin the distance from the threshold within which approximations are verified
+ * @param prefilter the minimum winnowing overlap of a pair compared exactly
+ * @param cache whether the persistent score cache is used
+*/
+struct Options {
+    std::string estimator;
+    std::string normalization;
+    double threshold;
+    int dof;
+    std::size_t gst_minimum;
+    bool chunking;
+    bool approximate;
+    std::size_t repetitions;
+    std::optional<double> verify_margin;
+    std::optional<double> prefilter;
+    bool cache;
+};
+
+/**
+ * The counters of the pair scoring.
+ * 
+ * @param incompatible the file pairs of incompatible languages
+ * @param pruned the file pairs not colliding in the LSH index
+ * @param duplicates the identical file pairs
+ * @param prefiltered the file pairs below the prefilter
+ * @param verified the approximations verified exactly
+ * @param batches the calls of the batched Levenshtein kernel
+ * @param deferred the file pairs left unevaluated by the best-first order
+*/
+struct Statistics {
+    std::size_t incompatible;
+    std::size_t pruned;
+    std::size_t duplicates;
+    std::size_t prefiltered;
+    std::size_t verified;
+    std::size_t batches;
+    std::size_t deferred;
+};
+
+/**
+ * The outcome of screening a file pair.
+ * 
+ * @param skipped the pair is never compared, its score stays zero
+ * @param scored the score is known without the exact estimator
+ * @param pending the pair must be compared by the exact estimator
+*/
+enum class Verdict {
+    skipped,
+    scored,
+    pending,
+};
+
+/**
+ * The screening of a file pair.
+ * 
+ * @param verdict the outcome
+ * @param score the score, if the pair was scored
+*/
+struct Screening {
+    Verdict verdict;
+    double score;
+};
+
+/**
+ * Scorer of the file pairs, from the cheapest checks to the exact estimators.
+ * 
+ * @note the scoring methods are thread-safe
+ * @note the preparations must precede any scoring
+*/
+class Pipeline {
+ public:
+    /**
+     * Creates the pipeline.
+     * 
+     * @param options the settings
+     * @param contents the store of the loaded files
+     * @param pool the pool of the workers, shared with the parallel Levenshtein
+     * 
+     * @note the kernels are measured only if some pair may be compared by Levenshtein
+    */
+    Pipeline(const Options& options, contents::Store& contents, BS::thread_pool& pool);
+
+    /**
+     * Detects the languages of the files, once per file.
+     * 
+     * @param files the files of the submissions
+     * @param compatibilities the groups of the compatible languages
+     * @param pool the pool of the workers
+    */
+    void classify(const Submissions& files, const languages::Table& compatibilities, BS::thread_pool& pool);
+
+    /**
+     * Indexes the fingerprints of the files by `LSH`, pruning the pairs that never collide.
+     * 
+     * @param files the files of the submissions
+     * @param bands the number of bands
+     * @param rows the number of rows per band
+     * @param pool the pool of the workers
+     * 
+     * @note the colliding pairs are read from the buckets, not found by comparing all pairs
+    */
+    void bucket(const Submissions& files, std::size_t bands, std::size_t rows, BS::thread_pool& pool);
+
+    /**
+     * Finds the fragment coverage of every cohort file pair in a single pass.
+     * 
+     * @param files the files of the submissions
+     * 
+     * @note fragments within a submission are not plagiarism
+    */
+    void cover(const Submissions& files);
+
+    /**
+     * Checks if the languages of the files may be compared.
+     * 
+     * @param lhs the file to be compared
+     * @param rhs the file to be compared
+     * @return if the files are compatible
+    */
+    bool compatible(const contents::Content& lhs, const contents::Content& rhs);
+
+    /**
+     * Screens the pair: compatibility, `LSH` buckets, cheap scores and the score cache.
+     * 
+     * @param lhs the file to be compared
+     * @param rhs the file to be compared
+     * @return the screening
+    */
+    Screening triage(const contents::Content& lhs, const contents::Content& rhs);
+
+    /**
+     * Scores the pair of files outside of the cohort, e.g. retrieved from the corpus.
+     * 
+     * @param lhs the file to be compared
+     * @param rhs the file to be compared
+     * @return the score
+     * 
+     * @note the pair is neither checked for compatibility nor bucketed
+    */
+    double estimate(const contents::Content& lhs, const contents::Content& rhs);
+
+    /**
+     * Bounds what `estimate` may return for the file and any file of the submission.
+     * 
+     * @param lhs the file to be compared
+     * @param sketch the sketch of the submission
+     * @return the upper bound of the scores
+    */
+    double bound(const contents::Content& lhs, const sketches::Sketch& sketch) const;
+
+    /**
+     * Fills the cells of the matrix row, the columns being a range of the rhs files.
+     * 
+     * @param matrix the matrix of the submission pair
+     * @param lidx the row
+     * @param lhs_files the files of the rows
+     * @param rhs_files the files of the columns
+     * @param first the first column
+     * @param last the column past the last one
+    */
+    void fill(
+        matrices::Dense& matrix,
+        std::size_t lidx,
+        const std::vector<std::filesystem::path>& lhs_files,
+        const std::vector<std::filesystem::path>& rhs_files,
+        std::size_t first,
+        std::size_t last);
+
+    /**
+     * Fills the row in the descending order of the bounds, while a cell may enter the top-DOF.
+     * 
+     * @param matrix the matrix of the submission pair
+     * @param lidx the row
+     * @param lhs_files the files of the rows
+     * @param rhs_files the files of the columns
+    */
+    void descend(
+        matrices::Dense& matrix,
+        std::size_t lidx,
+        const std::vector<std::filesystem::path>& lhs_files,
+        const std::vector<std::filesystem::path>& rhs_files);
+
+    /**
+     * Checks if whole files are compared by Levenshtein, several candidates per kernel call.
+     * 
+     * @return if the pairs are batched
+    */
+    bool batched(void) const;
+
+    /**
+     * Collects the counters.
+     * 
+     * @return the statistics
+    */
+    Statistics statistics(void) const;
+
+    /**
+     * Describes the executed plans.
+     * 
+     * @return the lines of the description, one per strategy used
+     * 
+     * @note nothing is described for the token estimators
+    */
+    std::vector<std::string> explain(void) const;
+
+ private:
+    scorecache::Key key_(const contents::Content& lhs, const contents::Content& rhs) const;
+    std::string dialect_(const contents::Content& content) const;
+    bool collide_(const contents::Content& lhs, const contents::Content& rhs) const;
+    std::optional<double> screen_(const contents::Content& lhs, const contents::Content& rhs);
+    planner::Outcome compute_(const contents::Content& lhs, const contents::Content& rhs);
+    double score_(const contents::Content& lhs, const contents::Content& rhs);
+    std::optional<double> solo_(
+        const planner::Plan& plan,
+        const contents::Content& lhs,
+        const contents::Content& rhs);
+    std::vector<double> batch_(
+        const contents::Content& lhs,
+        const std::vector<const contents::Content*>& candidates,
+        double predicted);
+
+    Options options_;
+    contents::Store& contents_;
+
+    bool gst_;
+    bool batched_;
+
+    languages::Table compatibilities_;
+    std::unordered_map<std::string, std::string> dialects_;
+
+    bool bucketed_ = false;
+    std::unordered_map<std::string, std::unordered_set<std::string>> neighbours_;
+
+    std::unique_ptr<fragments::Coverage> coverage_;
+    std::unordered_map<const contents::Content*, std::size_t> streams_;
+
+    chunks::Store units_;
+    cgk::Store embeddings_;
+    planner::Planner strategist_;
+
+    std::atomic<std::size_t> incompatible_ = 0;
+    std::atomic<std::size_t> pruned_ = 0;
+    std::atomic<std::size_t> duplicates_ = 0;
+    std::atomic<std::size_t> prefiltered_ = 0;
+    std::atomic<std::size_t> verified_ = 0;
+    std::atomic<std::size_t> batches_ = 0;
+    std::atomic<std::size_t> deferred_ = 0;
+};
+
+}  // namespace pipeline
+
+#endif  // SRC_PIPELINE_PIPELINE_HPP_
@@ -0,0 +1,272 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/planner/planner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <random>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+#include "src/estimators/alpha/alpha.hpp"
+#include "src/kernels/kernels.hpp"
+#include "src/sketches/sketches.hpp"
+
+namespace __planner {
+
+constexpr double epsilon = 1e-9;
+
+/* The tiles of the `parallel` strategy are 16 words high */
+constexpr std::size_t height = 16;
+
+/* Long enough to hide the timer resolution */
+constexpr std::chrono::milliseconds budget{5};
+
+std::string random(std::size_t length, std::mt19937& generator) {
+    std::uniform_int_distribution<int> symbols('a', 'z');
+
+    std::string text(length, ' ');
+    for (auto& symbol : text) {
+        symbol = static_cast<char>(symbols(generator));
+    }
+
+    return text;
+}
+
+/* Returns the number of units processed per second */
+template <typename Function>
+double rate(double units, Function function) {
+    using clock = std::chrono::steady_clock;
+
+    std::size_t calls = 0;
+    auto start = clock::now();
+
+    do {
+        function();
+        calls += 1;
+    } while (clock::now() - start < budget);
+
+    std::chrono::duration<double> elapsed = clock::now() - start;
+    return units * calls / elapsed.count();
+}
+
+}  // namespace __planner
+
+std::string planner::name(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::bound:
+            return "bound";
+        case Strategy::dp:
+            return "dp";
+        case Strategy::banded:
+            return "banded";
+        case Strategy::bitparallel:
+            return "bitparallel";
+        default:
+            return "parallel";
+    }
+}
+
+planner::Throughput planner::measure() {
+    std::mt19937 generator(0);
+
+    auto short_lhs = __planner::random(256, generator);
+    auto short_rhs = __planner::random(256, generator);
+
+    auto cells = __planner::rate(256.0 * 256.0, [&] {
+        kernels::levenshtein(short_lhs, short_rhs, short_lhs.size());
+    });
+
+    auto long_lhs = __planner::random(4096, generator);
+    auto long_rhs = __planner::random(4096, generator);
+
+    auto words = __planner::rate(64.0 * 4096.0, [&] {
+        kernels::levenshtein(std::string_view{long_lhs}, std::string_view{long_rhs});
+    });
+
+    auto tiny_lhs = __planner::random(16, generator);
+    auto tiny_rhs = __planner::random(16, generator);
+
+    auto calls = __planner::rate(1.0, [&] {
+        kernels::levenshtein(std::string_view{tiny_lhs}, std::string_view{tiny_rhs});
+    });
+
+    auto setup = std::max(0.0, 1.0 / calls - 16.0 / words);
+
+    return Throughput{cells, words, setup};
+}
+
+planner::Planner::Planner(double threshold, BS::thread_pool& pool, Throughput throughput)
+    : threshold_(threshold), pool_(&pool), throughput_(throughput) {
+    if (!(throughput.cells > 0 && throughput.words > 0 && throughput.setup >= 0)) {
+        constexpr auto detail = "The throughput must be positive";
+        throw std::runtime_error(detail);
+    }
+}
+
+planner::Plan planner::Planner::plan(const contents::Content& lhs, const contents::Content& rhs) const {
+    auto maxlen = static_cast<double>(std::max(lhs.text.size(), rhs.text.size()));
+
+    /* A score is at least the threshold if the distance is at most the limit */
+    auto share = std::clamp(1.0 - this->threshold_, 0.0, 1.0);
+    auto limit = static_cast<std::size_t>(std::floor(share * maxlen + __planner::epsilon));
+
+    if (sketches::levenshtein(lhs, rhs) + __planner::epsilon < this->threshold_) {
+        return Plan{Strategy::bound, 256.0 / this->throughput_.cells, limit};
+    }
+
+    /* Every kernel strips the common affixes first */
+    std::string_view lhs_text = lhs.text;
+    std::string_view rhs_text = rhs.text;
+
+    auto prefix = std::mismatch(lhs_text.begin(), lhs_text.end(), rhs_text.begin(), rhs_text.end());
+    lhs_text.remove_prefix(prefix.first - lhs_text.begin());
+    rhs_text.remove_prefix(prefix.second - rhs_text.begin());
+
+    auto suffix = std::mismatch(lhs_text.rbegin(), lhs_text.rend(), rhs_text.rbegin(), rhs_text.rend());
+    lhs_text.remove_suffix(suffix.first - lhs_text.rbegin());
+    rhs_text.remove_suffix(suffix.second - rhs_text.rbegin());
+
+    auto longer = static_cast<double>(std::max(lhs_text.size(), rhs_text.size()));
+    auto shorter = static_cast<double>(std::min(lhs_text.size(), rhs_text.size()));
+
+    auto cells = longer * shorter;
+    auto words = std::ceil(shorter / 64) * longer;
+
+    Plan best{Strategy::dp, cells / this->throughput_.cells, limit};
+
+    auto consider = [&best](Strategy strategy, double cost) {
+        if (cost < best.cost) {
+            best.strategy = strategy;
+            best.cost = cost;
+        }
+    };
+
+    auto band = std::min(cells, (2.0 * limit + 1) * shorter);
+    consider(Strategy::banded, band / this->throughput_.cells);
+
+    auto setup = this->throughput_.setup * std::ceil(shorter / 64);
+    consider(Strategy::bitparallel, setup + words / this->throughput_.words);
+
+    /* The tiles of an anti-diagonal are at most as many as the rows of tiles */
+    auto threads = this->pool_->get_thread_count();
+
+    if (threads > 1 && shorter > estimators::alpha::parallel::threshold) {
+        auto rows = std::ceil(std::ceil(shorter / 64) / __planner::height);
+
+        /* The helper tasks queue behind the pending pairs, so only the idle workers join the caller */
+        auto busy = std::min<std::size_t>(threads, this->pool_->get_tasks_total());
+        auto workers = std::min(static_cast<double>(threads - busy + 1), rows);
+
+        if (workers > 1) {
+            consider(Strategy::parallel, setup + words / this->throughput_.words / workers);
+        }
+    }
+
+    return best;
+}
+
+planner::Outcome planner::Planner::run(
+    const Plan& plan,
+    const contents::Content& lhs,
+    const contents::Content& rhs
+) {
+    auto start = std::chrono::steady_clock::now();
+
+    Outcome outcome{0.0, true};
+
+    auto maxlen = std::max(lhs.text.size(), rhs.text.size());
+
+    auto similarity = [maxlen](std::size_t distance) {
+        return (maxlen == 0) ? 1.0 : 1.0 - static_cast<double>(distance) / maxlen;
+    };
+
+    switch (plan.strategy) {
+        case Strategy::bound:
+            outcome = Outcome{0.0, false};
+            break;
+
+        case Strategy::dp:
+            outcome.score = similarity(kernels::levenshtein(lhs.text, rhs.text, maxlen));
+            break;
+
+        case Strategy::banded: {
+            auto distance = kernels::levenshtein(lhs.text, rhs.text, plan.limit);
+            outcome = Outcome{similarity(distance), distance <= plan.limit};
+            break;
+        }
+
+        case Strategy::bitparallel:
+            outcome.score = estimators::alpha::levenshtein(lhs.text, rhs.text);
+            break;
+
+        case Strategy::parallel:
+            outcome.score = estimators::alpha::parallel::levenshtein(lhs.text, rhs.text, *this->pool_);
+            break;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    this->record(plan.strategy, 1, plan.cost, elapsed.count());
+
+    return outcome;
+}
+
+void planner::Planner::record(Strategy strategy, std::size_t pairs, double predicted, double actual) {
+    std::lock_guard lock(this->mutex_);
+
+    auto& entry = this->ledger_[static_cast<std::size_t>(strategy)];
+
+    entry.pairs += pairs;
+    entry.predicted += predicted;
+    entry.actual += actual;
+}
+
+std::vector<std::string> planner::Planner::explain() const {
+    std::lock_guard lock(this->mutex_);
+
+    std::vector<std::string> lines;
+
+    lines.push_back(std::format(
+        "Plan: {:.3g} cells/s one by one, {:.3g} words/s bit-parallel",
+        this->throughput_.cells,
+        this->throughput_.words));
+
+    for (std::size_t idx = 0; idx < this->ledger_.size(); ++idx) {
+        const auto& entry = this->ledger_[idx];
+
+        if (entry.pairs == 0) {
+            continue;
+        }
+
+        lines.push_back(std::format(
+            "  {:<12} {:>10} pairs, predicted {:.3f} s, actual {:.3f} s",
+            planner::name(static_cast<Strategy>(idx)),
+            entry.pairs,
+            entry.predicted,
+            entry.actual));
+    }
+
+    return lines;
+}
@@ -0,0 +1,178 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_PLANNER_PLANNER_HPP_
+#define SRC_PLANNER_PLANNER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <BS_thread_pool.hpp>
+
+#include "src/contents/contents.hpp"
+
+namespace planner {
+
+/**
+ * The ways to compute the `Levenshtein` similarity of a file pair.
+ * 
+ * @note `bound` proves the pair below the threshold and computes nothing
+ * @note `dp` and `banded` fill the matrix cell by cell, `banded` only near the diagonal
+ * @note `bitparallel` fills 64 cells per word, `parallel` splits that between threads
+*/
+enum class Strategy {
+    bound,
+    dp,
+    banded,
+    bitparallel,
+    parallel,
+};
+
+/**
+ * Returns the name of the strategy.
+ * 
+ * @param strategy the strategy
+ * @return the name, e.g. `banded`
+*/
+std::string name(Strategy strategy);
+
+/**
+ * The measured speed of the kernels in use.
+ * 
+ * @param cells the matrix cells per second filled one by one
+ * @param words the 64-cell words per second filled bit-parallel
+ * @param setup the seconds spent on the match table of a bit-parallel call
+*/
+struct Throughput {
+    double cells;
+    double words;
+    double setup;
+};
+
+/**
+ * Measures the kernels on synthetic texts.
+ * 
+ * @return the throughput
+ * 
+ * @note takes a few milliseconds
+*/
+Throughput measure();
+
+/**
+ * The strategy chosen for the pair.
+ * 
+ * @param strategy the cheapest strategy
+ * @param cost the predicted time, in seconds
+ * @param limit the largest distance keeping the pair above the threshold
+*/
+struct Plan {
+    Strategy strategy;
+    double cost;
+    std::size_t limit;
+};
+
+/**
+ * The result of the plan.
+ * 
+ * @param score the similarity score
+ * @param exact whether the score equals `estimators::alpha::levenshtein`
+ * 
+ * @note inexact scores are below the threshold
+*/
+struct Outcome {
+    double score;
+    bool exact;
+};
+
+/**
+ * Chooser of the cheapest strategy per file pair.
+ * 
+ * @note thread-safe
+*/
+class Planner {
+ public:
+    /**
+     * Creates the planner.
+     * 
+     * @param threshold the alpha-threshold, lower scores need not be exact
+     * @param pool the pool of the workers, shared with the `parallel` strategy
+     * @param throughput the measured throughput
+    */
+    Planner(double threshold, BS::thread_pool& pool, Throughput throughput);
+
+    /**
+     * Chooses the cheapest strategy for the pair.
+     * 
+     * @param lhs the file to be compared
+     * @param rhs the file to be compared
+     * @return the plan
+    */
+    Plan plan(const contents::Content& lhs, const contents::Content& rhs) const;
+
+    /**
+     * Executes the plan and records it.
+     * 
+     * @param plan the plan of the pair
+     * @param lhs the file to be compared
+     * @param rhs the file to be compared
+     * @return the outcome
+    */
+    Outcome run(const Plan& plan, const contents::Content& lhs, const contents::Content& rhs);
+
+    /**
+     * Records the plans executed elsewhere, e.g. by a batched kernel.
+     * 
+     * @param strategy the strategy
+     * @param pairs the number of pairs
+     * @param predicted the predicted time, in seconds
+     * @param actual the measured time, in seconds
+    */
+    void record(Strategy strategy, std::size_t pairs, double predicted, double actual);
+
+    /**
+     * Describes the executed plans.
+     * 
+     * @return the lines of the description, one per strategy used
+    */
+    std::vector<std::string> explain() const;
+
+ private:
+    struct Entry {
+        std::size_t pairs;
+        double predicted;
+        double actual;
+    };
+
+    double threshold_;
+    BS::thread_pool* pool_;
+    Throughput throughput_;
+
+    mutable std::mutex mutex_{};
+
+    std::array<Entry, 5> ledger_{};
+};
+
+}  // namespace planner
+
+#endif  // SRC_PLANNER_PLANNER_HPP_
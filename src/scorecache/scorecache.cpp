@@ -0,0 +1,77 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/scorecache/scorecache.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <format>
+
+#include "src/kvcache/kvcache.hpp"
+
+namespace __scorecache {
+
+static std::atomic<std::size_t> hits = 0;
+static std::atomic<std::size_t> misses = 0;
+
+std::string serialize(const scorecache::Key& key) {
+    return std::format("{}:{}:{}:{}", key.estimator, key.normalization, key.lhs, key.rhs);
+}
+
+kvcache::Store& store(void) {
+    return kvcache::open("scores");
+}
+
+}  // namespace __scorecache
+
+std::optional<double> scorecache::tryread(const scorecache::Key& key) {
+    auto& store = __scorecache::store();
+    auto serialized = __scorecache::serialize(key);
+
+    if (!store.exists(serialized)) {
+        __scorecache::misses += 1;
+        return std::nullopt;
+    }
+
+    auto cached = store.read(serialized);
+
+    if (cached.value.size() != sizeof(double)) {
+        __scorecache::misses += 1;
+        return std::nullopt;
+    }
+
+    double score;
+    std::memcpy(&score, cached.value.data(), sizeof(double));
+
+    __scorecache::hits += 1;
+    return score;
+}
+
+void scorecache::write(const scorecache::Key& key, double score) {
+    std::string value(sizeof(double), '\0');
+    std::memcpy(value.data(), &score, sizeof(double));
+
+    __scorecache::store().write(__scorecache::serialize(key), value);
+}
+
+scorecache::Statistics scorecache::statistics(void) {
+    return {__scorecache::hits.load(), __scorecache::misses.load()};
+}
@@ -0,0 +1,86 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_SCORECACHE_SCORECACHE_HPP_
+#define SRC_SCORECACHE_SCORECACHE_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace scorecache {
+
+/**
+ * Representation of the score cache key.
+ * 
+ * @param lhs the digest of the left-hand contents
+ * @param rhs the digest of the right-hand contents
+ * @param estimator the identifier of the estimator
+ * @param normalization the revision of the normalization rules
+*/
+struct Key {
+    std::string lhs;
+    std::string rhs;
+    std::string estimator;
+    std::string normalization;
+};
+
+/**
+ * Representation of the score cache statistics.
+ * 
+ * @param hits the number of scores served from the cache
+ * @param misses the number of scores that had to be computed
+*/
+struct Statistics {
+    std::size_t hits;
+    std::size_t misses;
+};
+
+/**
+ * Looks up the score of the pair.
+ * 
+ * @param key the key of the pair
+ * @return the cached score, if any
+ * 
+ * @note thread-safe
+*/
+std::optional<double> tryread(const Key& key);
+
+/**
+ * Saves the score of the pair.
+ * 
+ * @param key the key of the pair
+ * @param score the score to be saved
+ * 
+ * @note thread-safe
+*/
+void write(const Key& key, double score);
+
+/**
+ * Gets the statistics collected since the start of the program.
+ * 
+ * @return the number of hits and misses
+*/
+Statistics statistics(void);
+
+}  // namespace scorecache
+
+#endif  // SRC_SCORECACHE_SCORECACHE_HPP_
@@ -0,0 +1,96 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <vector>
+
+#include "lib/logging/logging.hpp"
+
+#include "src/kvcache/kvcache.hpp"
+#include "src/scorecache/scorecache.hpp"
+
+namespace __scorecache::test {
+
+const auto directory = std::filesystem::temp_directory_path() / "gelada-scorecache-test";
+
+const scorecache::Key key{"0a1b", "2c3d", "levenshtein", "1"};
+
+/* The keys differing from `key` in exactly one field */
+std::vector<scorecache::Key> neighbours(void) {
+    return {
+        {"0a1c", "2c3d", "levenshtein", "1"},
+        {"0a1b", "2c3e", "levenshtein", "1"},
+        {"0a1b", "2c3d", "gst9", "1"},
+        {"0a1b", "2c3d", "levenshtein", "2"},
+        {"2c3d", "0a1b", "levenshtein", "1"},
+    };
+}
+
+}  // namespace __scorecache::test
+
+int main() {
+    namespace test = __scorecache::test;
+
+    try {
+        std::filesystem::remove_all(test::directory);
+        kvcache::configure(test::directory);
+
+        if (scorecache::tryread(test::key)) {
+            logging::error("The empty cache has a score");
+            return EXIT_FAILURE;
+        }
+
+        constexpr double score = 1.0 / 3.0;
+        scorecache::write(test::key, score);
+
+        auto cached = scorecache::tryread(test::key);
+
+        if (!cached || *cached != score) {
+            logging::error("The score is not read back exactly");
+            return EXIT_FAILURE;
+        }
+
+        /* The pipeline orders the digests itself, so the swapped pair is another key */
+        for (const auto& neighbour : test::neighbours()) {
+            if (scorecache::tryread(neighbour)) {
+                logging::error("The score is shared by different keys");
+                return EXIT_FAILURE;
+            }
+        }
+
+        auto statistics = scorecache::statistics();
+
+        if (statistics.hits != 1 || statistics.misses != 1 + test::neighbours().size()) {
+            logging::error("The hits and misses are miscounted");
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::remove_all(test::directory);
+    }
+    catch (const std::exception& error) {
+        logging::error(error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -22,12 +22,77 @@
 #include "src/shutil/shutil.hpp"
 
 #include <algorithm>
+#include <array>
+#include <fstream>
 
+#include "lib/pathlib/pathlib.hpp"
 #include "lib/tempfile/tempfile.hpp"
 
 #include "src/errors/filesystem/filesystem.hpp"
 
-std::filesystem::path shutil::seal(const std::filesystem::path& path) {
+namespace __shutil::filter {
+
+/* The same prefix is inspected by `git` */
+constexpr std::size_t sniff = 8000;
+
+bool is_binary(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+
+    std::array<char, sniff> buffer;
+    stream.read(buffer.data(), buffer.size());
+
+    auto end = buffer.begin() + stream.gcount();
+    return std::find(buffer.begin(), end, '\0') != end;
+}
+
+bool any_match(const std::filesystem::path& path, const std::vector<std::string>& patterns) {
+    return std::any_of(patterns.begin(), patterns.end(), [&](const std::string& pattern) {
+        return pathlib::match(path, pattern);
+    });
+}
+
+/* Patterns ending with a double star exclude the directory itself as well */
+bool excludes_directory(const std::filesystem::path& path, const shutil::Filter& filter) {
+    return std::any_of(filter.exclude.begin(), filter.exclude.end(), [&](const std::string& pattern) {
+        if (pathlib::match(path, pattern)) {
+            return true;
+        }
+
+        if (!pattern.ends_with("/**")) {
+            return false;
+        }
+
+        /* The leading slash anchors the prefix, a bare `vendor` would match at any depth */
+        auto prefix = pattern.substr(0, pattern.size() - 3);
+        return pathlib::match(path, prefix.starts_with('/') ? prefix : "/" + prefix);
+    });
+}
+
+/* The cheapest checks go first, the contents are read last */
+bool keeps(
+    const std::filesystem::path& path,
+    const std::filesystem::path& relative,
+    const shutil::Filter& filter
+) {
+    if (!filter.include.empty() && !any_match(relative, filter.include)) {
+        return false;
+    }
+
+    if (any_match(relative, filter.exclude)) {
+        return false;
+    }
+
+    auto size = std::filesystem::file_size(path);
+    if (size < filter.min_size || size > filter.max_size) {
+        return false;
+    }
+
+    return filter.binary || !is_binary(path);
+}
+
+}  // namespace __shutil::filter
+
+std::filesystem::path shutil::seal(const std::filesystem::path& path, const shutil::Filter& filter) {
     if (!std::filesystem::exists(path)) {
         throw errors::filesystem::FileNotFoundError(path);
     }
@@ -37,14 +102,40 @@ std::filesystem::path shutil::seal(const std::filesystem::path& path) {
     }
 
     auto to = tempfile::mkdtemp();
+
     if (std::filesystem::is_regular_file(path)) {
-        to /= path.filename();
+        if (__shutil::filter::keeps(path, path.filename(), filter)) {
+            std::filesystem::copy_file(path, to / path.filename());
+        }
+
+        return to;
     }
 
-    constexpr auto options = std::filesystem::copy_options::recursive
-                           | std::filesystem::copy_options::skip_symlinks;
+    auto iterator = std::filesystem::recursive_directory_iterator(path);
+
+    for (auto it = std::filesystem::begin(iterator); it != std::filesystem::end(iterator); ++it) {
+        const auto& entry = *it;
+        auto relative = entry.path().lexically_relative(path);
+
+        /* Symlinked directories are not followed by the iterator */
+        if (entry.is_symlink()) {
+            continue;
+        }
 
-    std::filesystem::copy(path, to, options);
+        if (entry.is_directory()) {
+            if (__shutil::filter::excludes_directory(relative, filter)) {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+
+        if (!entry.is_regular_file() || !__shutil::filter::keeps(entry.path(), relative, filter)) {
+            continue;
+        }
+
+        std::filesystem::create_directories(to / relative.parent_path());
+        std::filesystem::copy_file(entry.path(), to / relative);
+    }
 
-    return std::filesystem::is_directory(to) ? to : to.parent_path();
+    return to;
 }
@@ -22,21 +22,46 @@
 #ifndef SRC_SHUTIL_SHUTIL_HPP_
 #define SRC_SHUTIL_SHUTIL_HPP_
 
+#include <cstdint>
 #include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace shutil {
 
+/**
+ * Rules of the files to be isolated.
+ * 
+ * @param include the globs of the files to be kept, every file if empty
+ * @param exclude the globs of the files and the directories to be skipped
+ * @param min_size the minimum size of a file, in bytes
+ * @param max_size the maximum size of a file, in bytes
+ * @param binary whether to keep the files containing null bytes
+ * 
+ * @note the globs are matched against the paths relative to the object
+*/
+struct Filter {
+    std::vector<std::string> include{};
+    std::vector<std::string> exclude{};
+    std::uintmax_t min_size = 0;
+    std::uintmax_t max_size = std::numeric_limits<std::uintmax_t>::max();
+    bool binary = true;
+};
+
 /**
  * Isolates the file system object.
  * 
  * @param path the path to the object
+ * @param filter the rules of the files to be isolated
  * @return the path to an isolated object
  * 
  * @note symlinks are ignored
  * @note regular files are added to a directory
  * @note the return value is always a directory
+ * @note excluded directories are not traversed at all
 */
-std::filesystem::path seal(const std::filesystem::path& path);
+std::filesystem::path seal(const std::filesystem::path& path, const Filter& filter = {});
 
 }  // namespace shutil
 
@@ -0,0 +1,110 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/sketches/sketches.hpp"
+
+#include <algorithm>
+
+#include "src/fingerprints/fingerprints.hpp"
+#include "src/kernels/kernels.hpp"
+
+sketches::Sketch sketches::build(const std::vector<const contents::Content*>& files) {
+    Sketch sketch;
+    sketch.histogram.fill(0);
+    sketch.fingerprinted = true;
+
+    for (const auto* file : files) {
+        for (std::size_t symbol = 0; symbol < sketch.histogram.size(); ++symbol) {
+            sketch.histogram[symbol] = std::max(sketch.histogram[symbol], file->histogram[symbol]);
+        }
+
+        sketch.lengths.push_back(file->text.size());
+        sketch.fingerprinted = sketch.fingerprinted && !file->fingerprints.empty();
+
+        sketch.fingerprints.insert(
+            sketch.fingerprints.end(),
+            file->fingerprints.begin(),
+            file->fingerprints.end());
+    }
+
+    std::sort(sketch.lengths.begin(), sketch.lengths.end());
+
+    std::sort(sketch.fingerprints.begin(), sketch.fingerprints.end());
+    sketch.fingerprints.erase(
+        std::unique(sketch.fingerprints.begin(), sketch.fingerprints.end()),
+        sketch.fingerprints.end());
+
+    return sketch;
+}
+
+double sketches::levenshtein(const contents::Content& file, const Sketch& sketch) {
+    auto length = file.text.size();
+
+    if (sketch.lengths.empty()) {
+        return 0.0;
+    }
+
+    if (length == 0) {
+        return sketch.lengths.front() == 0 ? 1.0 : 0.0;
+    }
+
+    /* Every kept symbol of an alignment is a common symbol: d >= maxlen - common */
+    auto common = kernels::overlap(file.histogram, sketch.histogram);
+
+    auto by_histogram = static_cast<double>(common) / length;
+
+    /* The distance is at least the difference of the lengths */
+    auto pivot = std::lower_bound(sketch.lengths.begin(), sketch.lengths.end(), length);
+
+    double by_length = 0.0;
+
+    if (pivot != sketch.lengths.end()) {
+        by_length = std::max(by_length, static_cast<double>(length) / *pivot);
+    }
+
+    if (pivot != sketch.lengths.begin()) {
+        by_length = std::max(by_length, static_cast<double>(*std::prev(pivot)) / length);
+    }
+
+    return std::min(by_histogram, by_length);
+}
+
+double sketches::levenshtein(const contents::Content& lhs, const contents::Content& rhs) {
+    auto maxlen = std::max(lhs.text.size(), rhs.text.size());
+
+    if (maxlen == 0) {
+        return 1.0;
+    }
+
+    /* Every kept symbol of an alignment is a common symbol, at most the shorter length */
+    auto common = kernels::overlap(lhs.histogram, rhs.histogram);
+
+    return static_cast<double>(common) / maxlen;
+}
+
+double sketches::winnowing(const contents::Content& file, const Sketch& sketch) {
+    if (file.fingerprints.empty()) {
+        return 1.0;
+    }
+
+    auto shared = fingerprints::overlap(file.fingerprints, sketch.fingerprints);
+    return static_cast<double>(shared) / file.fingerprints.size();
+}
@@ -0,0 +1,90 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_SKETCHES_SKETCHES_HPP_
+#define SRC_SKETCHES_SKETCHES_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/contents/contents.hpp"
+
+namespace sketches {
+
+/**
+ * Representation of the submission summarized for upper bounds.
+ * 
+ * @param histogram the maximum number of occurrences of every byte in a file
+ * @param lengths the sorted lengths of the files
+ * @param fingerprints the sorted union of the fingerprints of the files
+ * @param fingerprinted whether every file has fingerprints
+*/
+struct Sketch {
+    std::array<std::size_t, 256> histogram;
+    std::vector<std::size_t> lengths;
+    std::vector<std::uint64_t> fingerprints;
+    bool fingerprinted;
+};
+
+/**
+ * Summarizes the files of the submission.
+ * 
+ * @param files the files of the submission
+ * @return the sketch of the submission
+*/
+Sketch build(const std::vector<const contents::Content*>& files);
+
+/**
+ * Bounds the `Levenshtein` similarity of the file and any file of the submission.
+ * 
+ * @param file the file to be compared
+ * @param sketch the sketch of the submission
+ * @return the upper bound of `estimators::alpha::levenshtein`
+ * 
+ * @note uses the byte histograms and the lengths, so it is exact rather than probabilistic
+*/
+double levenshtein(const contents::Content& file, const Sketch& sketch);
+
+/**
+ * Bounds the `Levenshtein` similarity of the files.
+ * 
+ * @param lhs the file to be compared
+ * @param rhs the file to be compared
+ * @return the upper bound of `estimators::alpha::levenshtein`
+ * 
+ * @note uses the byte histograms and the lengths, so it is exact rather than probabilistic
+*/
+double levenshtein(const contents::Content& lhs, const contents::Content& rhs);
+
+/**
+ * Bounds the fingerprint similarity of the file and any file of the submission.
+ * 
+ * @param file the file to be compared
+ * @param sketch the sketch of the submission
+ * @return the upper bound of `estimators::alpha::winnowing`
+*/
+double winnowing(const contents::Content& file, const Sketch& sketch);
+
+}  // namespace sketches
+
+#endif  // SRC_SKETCHES_SKETCHES_HPP_
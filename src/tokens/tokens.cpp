@@ -0,0 +1,93 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tokens/tokens.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <string_view>
+
+namespace __tokens::lexeme {
+
+/* Bytes of the multibyte UTF-8 sequences are treated as letters */
+bool is_word(char symbol) {
+    auto byte = static_cast<unsigned char>(symbol);
+    return std::isalnum(byte) || symbol == '_' || byte >= 0x80;
+}
+
+bool is_quote(char symbol) {
+    return symbol == '"' || symbol == '\'' || symbol == '`';
+}
+
+/* FNV-1a */
+std::uint32_t identify(std::string_view lexeme) {
+    std::uint32_t hash = 0x811C9DC5U;
+
+    for (auto symbol : lexeme) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 0x01000193U;
+    }
+
+    return hash;
+}
+
+}  // namespace __tokens::lexeme
+
+std::vector<std::uint32_t> tokens::tokenize(const std::string& text) {
+    std::vector<std::uint32_t> stream;
+    std::string_view view(text);
+
+    std::size_t idx = 0;
+
+    while (idx < view.size()) {
+        auto symbol = view[idx];
+
+        if (std::isspace(static_cast<unsigned char>(symbol))) {
+            idx += 1;
+            continue;
+        }
+
+        auto start = idx;
+
+        if (__tokens::lexeme::is_word(symbol)) {
+            while (idx < view.size() && __tokens::lexeme::is_word(view[idx])) {
+                idx += 1;
+            }
+        } else if (__tokens::lexeme::is_quote(symbol)) {
+            idx += 1;
+
+            /* Unterminated literals end at the line break */
+            while (idx < view.size() && view[idx] != symbol && view[idx] != '\n') {
+                idx += (view[idx] == '\\' && idx + 1 < view.size()) ? 2 : 1;
+            }
+
+            if (idx < view.size() && view[idx] == symbol) {
+                idx += 1;
+            }
+        } else {
+            idx += 1;
+        }
+
+        stream.push_back(__tokens::lexeme::identify(view.substr(start, idx - start)));
+    }
+
+    return stream;
+}
@@ -0,0 +1,45 @@
+//  ██████╗ ███████╗██╗      █████╗ ██████╗  █████╗
+// ██╔════╝ ██╔════╝██║     ██╔══██╗██╔══██╗██╔══██╗
+// ██║  ███╗█████╗  ██║     ███████║██║  ██║███████║
+// ██║   ██║██╔══╝  ██║     ██╔══██║██║  ██║██╔══██║
+// ╚██████╔╝███████╗███████╗██║  ██║██████╔╝██║  ██║
+//  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝
+//
+// Copyright 2024 Sergei Bogdanov <syubogdanov@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TOKENS_TOKENS_HPP_
+#define SRC_TOKENS_TOKENS_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tokens {
+
+/**
+ * Splits the text into a stream of token identifiers.
+ * 
+ * @param text the text to be tokenized
+ * @return the identifiers of the tokens in order
+ * 
+ * @note identifiers, numbers and string literals are single tokens
+ * @note every other non-whitespace character is a token of its own
+ * @note equal lexemes share the identifier
+*/
+std::vector<std::uint32_t> tokenize(const std::string& text);
+
+}  // namespace tokens
+
+#endif  // SRC_TOKENS_TOKENS_HPP_